@@ -0,0 +1,41 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Alignment.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mskinner <v.golskiy@ya.ru>                 +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/06/11 11:47:52 by mskinner          #+#    #+#             */
+/*   Updated: 2021/06/11 11:47:52 by mskinner         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Alignment of a type for the allocators of List/, in a header of its own:
+** Libraries.hpp of Map/ and Vector/ share the include guard of the one of List/.
+*/
+
+#pragma once
+
+#ifndef _ALIGNMENT_HPP_
+# define _ALIGNMENT_HPP_
+
+# include <cstddef>
+
+namespace ft
+{
+	//Alignment requirement of T, measured on a struct where T follows a single char
+	template <typename T>
+	struct alignment_of {
+	private:
+		struct probe {
+			char	c;
+			T		t;
+		};
+
+	public:
+		static const std::size_t	value = sizeof(probe) - sizeof(T);
+	};
+}
+
+#endif
@@ -39,6 +39,12 @@ namespace ft
 			typedef Allocator<U> other;
 		};
 
+		//std-style spelling of conv, for containers written against std allocators
+		template<typename U>
+		struct rebind {
+			typedef Allocator<U> other;
+		};
+
 		Allocator() {};
 		~Allocator() {};
 	    Allocator(const Allocator &) {};
@@ -57,8 +63,9 @@ namespace ft
 
 		//https://stackoverflow.com/questions/1183700/what-is-the-meaning-of-this-c-error-stdlength-error
 		//Allocates n * sizeof(T) bytes of uninitialized storage by calling ::operator new(std::size_t)
+		//cnt is checked against max_size() before the multiplication can overflow
 		pointer			allocate(size_type cnt, const void * = 0) { 
-			if ((cnt * sizeof(T)) > max_size())
+			if (cnt > max_size())
 				throw std::bad_alloc();
 			return (reinterpret_cast<pointer>(::operator new(cnt * sizeof(T)))); 
 		};
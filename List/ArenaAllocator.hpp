@@ -0,0 +1,248 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ArenaAllocator.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mskinner <v.golskiy@ya.ru>                 +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/06/10 14:21:03 by mskinner          #+#    #+#             */
+/*   Updated: 2021/06/10 14:21:03 by mskinner         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Monotonic arena: memory is bump-allocated from large chunks and given back
+** all at once by reset() or by the arena destructor.
+** + an allocation is a pointer increment, deallocation costs nothing,
+** + objects allocated together are contiguous in memory,
+** + an initial buffer (e.g. on the stack) is used before any chunk is taken from the heap;
+** - memory of erased elements is not reused until reset(),
+** - containers using the arena must be destroyed (or never touched again) before reset().
+**
+** char		buffer[4096];
+** ft::Arena	arena(buffer, sizeof(buffer));
+** ft::list<int, ft::ArenaAllocator<int> >	numbers((ft::ArenaAllocator<int>(arena)));
+*/
+
+#pragma once
+
+#ifndef _ARENA_ALLOCATOR_HPP_
+# define _ARENA_ALLOCATOR_HPP_
+
+# include "Libraries.hpp"
+# include "Alignment.hpp"
+
+namespace ft
+{
+	class Arena
+	{
+	private:
+		//Header of a heap chunk, chunk storage follows it
+		struct Chunk {
+			Chunk		*_next;
+			std::size_t	_size;
+		};
+
+		Chunk		*_chunks;
+		char		*_current;
+		char		*_limit;
+		char		*_buffer;
+		std::size_t	_buffer_size;
+		std::size_t	_chunk_size;
+		std::size_t	_allocated;
+
+		//Arenas own their chunks, they are neither copied nor assigned
+		Arena(const Arena &);
+		Arena&	operator=(const Arena &);
+
+		static std::size_t	align_up(std::size_t value, std::size_t alignment) {
+			return ((value + alignment - 1) & ~(alignment - 1));
+		};
+
+		//Takes a new chunk from the heap, big enough for bytes at the worst alignment
+		void	grow(std::size_t bytes, std::size_t alignment) {
+			std::size_t	header = align_up(sizeof(Chunk), sizeof(long double));
+			std::size_t	size = bytes + alignment;
+			Chunk		*chunk;
+
+			if (size < _chunk_size)
+				size = _chunk_size;
+			chunk = static_cast<Chunk *>(::operator new(header + size));
+			chunk->_next = _chunks;
+			chunk->_size = size;
+			_chunks = chunk;
+			_current = reinterpret_cast<char *>(chunk) + header;
+			_limit = _current + size;
+		};
+
+	public:
+		static const std::size_t	default_chunk_size = 64 * 1024;
+
+		//Arena taking chunk_size bytes chunks from the heap
+		explicit Arena(std::size_t chunk_size = default_chunk_size) :
+			_chunks(NULL), _current(NULL), _limit(NULL), _buffer(NULL), _buffer_size(0),
+			_chunk_size(chunk_size), _allocated(0) {};
+
+		//Arena serving requests from buffer first, then from chunk_size bytes heap chunks
+		Arena(void *buffer, std::size_t buffer_size, std::size_t chunk_size = default_chunk_size) :
+			_chunks(NULL), _current(static_cast<char *>(buffer)),
+			_limit(static_cast<char *>(buffer) + buffer_size), _buffer(static_cast<char *>(buffer)),
+			_buffer_size(buffer_size), _chunk_size(chunk_size), _allocated(0) {};
+
+		~Arena(void) {
+			reset();
+		};
+
+		//Returns bytes of storage aligned on alignment (a power of two)
+		void*	allocate(std::size_t bytes, std::size_t alignment) {
+			std::size_t	offset;
+
+			if (_current) {
+				offset = align_up(reinterpret_cast<std::size_t>(_current), alignment)
+					- reinterpret_cast<std::size_t>(_current);
+				if ((offset <= static_cast<std::size_t>(_limit - _current))
+					&& (bytes <= static_cast<std::size_t>(_limit - _current) - offset)) {
+					_current += offset;
+					_allocated += bytes;
+					_current += bytes;
+					return (_current - bytes);
+				}
+			}
+			grow(bytes, alignment);
+			return (allocate(bytes, alignment));
+		};
+
+		//Frees every chunk at once, the initial buffer is reused from its start
+		void	reset(void) {
+			Chunk	*next;
+
+			while (_chunks) {
+				next = _chunks->_next;
+				::operator delete(_chunks);
+				_chunks = next;
+			}
+			_current = _buffer;
+			_limit = _buffer + _buffer_size;
+			_allocated = 0;
+		};
+
+		//Bytes handed out since construction or the last reset()
+		std::size_t	allocated(void) const {
+			return (_allocated);
+		};
+
+		//Number of heap chunks currently held
+		std::size_t	chunks(void) const {
+			std::size_t	count = 0;
+			Chunk		*chunk;
+
+			for (chunk = _chunks; chunk; chunk = chunk->_next)
+				count++;
+			return (count);
+		};
+
+		std::size_t	chunk_size(void) const {
+			return (_chunk_size);
+		};
+	};
+
+	/*
+	** Allocator drawing from an ft::Arena, deallocate() is a no-op.
+	** Copies and rebound copies (conv<U>::other) share the same arena,
+	** so every container built from one allocator draws from one arena.
+	** A default-constructed allocator has no arena and behaves as ft::Allocator.
+	*/
+	template <typename T>
+	class ArenaAllocator
+	{
+	private:
+		Arena	*_arena;
+
+	//Member types
+	public:
+		typedef T											value_type;
+		typedef T											&reference;
+		typedef T											*pointer;
+		typedef const T										&const_reference;
+		typedef const T										*const_pointer;
+		typedef std::size_t									size_type;
+		typedef std::ptrdiff_t								difference_type;
+
+		template<typename U>
+		struct conv {
+			typedef ArenaAllocator<U> other;
+		};
+
+		//std-style spelling of conv, for containers written against std allocators
+		template<typename U>
+		struct rebind {
+			typedef ArenaAllocator<U> other;
+		};
+
+		ArenaAllocator() : _arena(NULL) {};
+		explicit ArenaAllocator(Arena &arena) : _arena(&arena) {};
+		~ArenaAllocator() {};
+		ArenaAllocator(const ArenaAllocator &copy) : _arena(copy._arena) {};
+
+		template<typename U>
+		ArenaAllocator(const ArenaAllocator<U> &copy) : _arena(copy.arena()) {};
+
+		ArenaAllocator&	operator=(const ArenaAllocator &other) {
+			_arena = other._arena;
+			return (*this);
+		};
+
+		Arena*			arena(void) const {
+			return (_arena);
+		};
+
+		//Getting located memory pointers
+		pointer			address(reference ref) const {
+			return (&ref);
+		};
+
+		const_pointer	address(const_reference ref) const {
+			return (&ref);
+		};
+
+		//Bumps cnt * sizeof(T) bytes out of the arena
+		pointer			allocate(size_type cnt, const void * = 0) {
+			if (cnt > max_size())
+				throw std::bad_alloc();
+			if (!_arena)
+				return (static_cast<pointer>(::operator new(cnt * sizeof(T))));
+			return (static_cast<pointer>(_arena->allocate(cnt * sizeof(T), alignment_of<T>::value)));
+		};
+
+		//Memory goes back to the system on Arena::reset() only
+		void			deallocate(pointer p, size_type) {
+			if (!_arena)
+				::operator delete(p);
+		};
+
+		size_type		max_size() const {
+			return (std::numeric_limits<size_type>::max() / sizeof(value_type));
+		};
+
+		void			construct(pointer p, const_reference val) {
+			new(p) T(val);
+		};
+
+		void			destroy(pointer p) {
+			p->~T();
+		};
+	};
+
+	//Arena allocators are equal when they draw from the same arena
+	template <class T1, class T2>
+	bool			operator==(const ArenaAllocator<T1> &lhs, const ArenaAllocator<T2> &rhs) {
+		return (lhs.arena() == rhs.arena());
+	};
+
+	template <class T1, class T2>
+	bool			operator!=(const ArenaAllocator<T1> &lhs, const ArenaAllocator<T2> &rhs) {
+		return (lhs.arena() != rhs.arena());
+	};
+}
+
+#endif
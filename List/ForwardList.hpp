@@ -0,0 +1,711 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ForwardList.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mskinner <v.golskiy@ya.ru>                 +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/06/09 10:12:41 by mskinner          #+#    #+#             */
+/*   Updated: 2021/06/09 10:12:41 by mskinner         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Forward lists are singly linked sequence containers:
+** + one link per node, half of the ft::list linking overhead,
+** + constant time insert and erase after any known position,
+** + constant time splice of a single element, merge sort by relinking only;
+** - iteration in one direction only, no back() and no push_back(),
+** - operations are expressed "after" a position: before_begin() stands for the head.
+** Counted = false drops the size field and its bookkeeping from every modifier,
+** size() becomes linear.
+*/
+
+#pragma once
+
+#ifndef _FORWARD_LIST_HPP_
+# define _FORWARD_LIST_HPP_
+
+# include "Node.hpp"
+# include "Iterator.hpp"
+# include "Allocator.hpp"
+
+namespace ft
+{
+	//Element count of a Counted forward_list
+	template <bool Counted>
+	class ForwardCount
+	{
+	protected:
+		std::size_t	_size;
+
+		ForwardCount(void) : _size(0) {};
+
+		std::size_t	counted(void) const {
+			return (_size);
+		};
+
+		void		count_add(std::size_t count) {
+			_size += count;
+		};
+
+		void		count_remove(std::size_t count) {
+			_size -= count;
+		};
+
+		void		count_clear(void) {
+			_size = 0;
+		};
+
+		//Adds the count of other, which drops to zero
+		void		count_take(ForwardCount &other) {
+			_size += other._size;
+			other._size = 0;
+		};
+
+		void		count_swap(ForwardCount &other) {
+			std::size_t	size = _size;
+
+			_size = other._size;
+			other._size = size;
+		};
+	};
+
+	//Uncounted forward_list: no field at all, the empty base takes no room in the list
+	template <>
+	class ForwardCount<false>
+	{
+	protected:
+		std::size_t	counted(void) const {
+			return (0);
+		};
+
+		void		count_add(std::size_t) {};
+		void		count_remove(std::size_t) {};
+		void		count_clear(void) {};
+		void		count_take(ForwardCount &) {};
+		void		count_swap(ForwardCount &) {};
+	};
+
+	template <typename T, class Allocator = ft::Allocator<T>, bool Counted = true>
+	class forward_list : private ForwardCount<Counted>
+	{
+	private:
+		typedef ForwardNode<T>										node;
+		//Allocator rebound to the node type: every element node is taken from and returned to it
+		typedef typename Allocator::template conv<node>::other		node_allocator;
+
+		//Embedded head link: _head._next is the first element, NULL terminates the chain
+		ForwardLink		_head;
+		Allocator		_allocator;
+		node_allocator	_node_allocator;
+
+		//Nodes may only be relinked between lists whose node allocators can free each other's nodes
+		bool		shares_nodes(const forward_list &other) const {
+			return (_node_allocator == other._node_allocator);
+		};
+
+		struct less_than {
+			bool	operator()(const T &x, const T &y) const {
+				return (x < y);
+			};
+		};
+
+		struct equal_to {
+			bool	operator()(const T &x, const T &y) const {
+				return (x == y);
+			};
+		};
+
+		static T&	content(ForwardLink *link) {
+			return (static_cast<node *>(link)->_content);
+		};
+
+		/*
+		** Allocates a detached node and copies value right into it, T is copied once.
+		** Built by placement new, torn down by destroy_node's explicit destructor call.
+		*/
+		node*		create_node(const T &value) {
+			node	*added = _node_allocator.allocate(1);
+
+			try {
+				new(added) node(value);
+			}
+			catch (...) {
+				_node_allocator.deallocate(added, 1);
+				throw ;
+			}
+			return (added);
+		};
+
+		void		destroy_node(ForwardLink *link) {
+			node	*old = static_cast<node *>(link);
+
+			old->~node();
+			_node_allocator.deallocate(old, 1);
+		};
+
+		ForwardLink*	link_after(ForwardLink *pos, ForwardLink *added) {
+			added->_next = pos->_next;
+			pos->_next = added;
+			this->count_add(1);
+			return (added);
+		};
+
+		/*
+		** Appends a new node holding value to the detached chain [head, tail],
+		** built off to the side of the list. On throw the chain is left intact
+		** for the caller to release.
+		*/
+		void		append_to_chain(ForwardLink *&head, ForwardLink *&tail, const T &value) {
+			ForwardLink	*added = create_node(value);
+
+			if (tail)
+				tail->_next = added;
+			else
+				head = added;
+			tail = added;
+		};
+
+		//Links the detached chain [first, last] of count nodes after pos in one splice, returns last
+		ForwardLink*	link_chain_after(ForwardLink *pos, ForwardLink *first, ForwardLink *last, std::size_t count) {
+			last->_next = pos->_next;
+			pos->_next = first;
+			this->count_add(count);
+			return (last);
+		};
+
+		/*
+		** Unlinks the node following pos and pushes it on the released chain.
+		** Returns the new chain head.
+		*/
+		ForwardLink*	unlink_after(ForwardLink *pos, ForwardLink *released) {
+			ForwardLink	*old = pos->_next;
+
+			pos->_next = old->_next;
+			old->_next = released;
+			this->count_remove(1);
+			return (old);
+		};
+
+		//Releases a chain built by unlink_after in one pass, once the scan is over
+		void		release_nodes(ForwardLink *released) {
+			ForwardLink	*next;
+
+			while (released) {
+				next = released->_next;
+				destroy_node(released);
+				released = next;
+			}
+		};
+
+		static std::size_t	distance(ForwardLink *first, ForwardLink *last) {
+			std::size_t	count = 0;
+
+			for (; first != last; first = first->_next)
+				count++;
+			return (count);
+		};
+
+		//Merges two sorted NULL-terminated chains, equal elements of first go first
+		template <class Compare>
+		static ForwardLink*	merge_chains(ForwardLink *first, ForwardLink *second, Compare comp) {
+			ForwardLink	head;
+			ForwardLink	*tail = &head;
+
+			while (first && second) {
+				if (comp(content(second), content(first))) {
+					tail->_next = second;
+					second = second->_next;
+				}
+				else {
+					tail->_next = first;
+					first = first->_next;
+				}
+				tail = tail->_next;
+			}
+			tail->_next = (first) ? first : second;
+			return (head._next);
+		};
+
+		/*
+		** Bottom-up merge sort: bucket i holds a sorted run of 2^i nodes, every node taken
+		** from the list is carried up through the full buckets. O(n log n), no allocation.
+		*/
+		template <class Compare>
+		void		sort_chain(Compare comp) {
+			ForwardLink	*buckets[sizeof(std::size_t) * 8];
+			ForwardLink	*carry;
+			ForwardLink	*rest = _head._next;
+			std::size_t	filled = 0;
+			std::size_t	i;
+
+			while (rest) {
+				carry = rest;
+				rest = rest->_next;
+				carry->_next = NULL;
+				for (i = 0; (i < filled) && buckets[i]; i++) {
+					carry = merge_chains(buckets[i], carry, comp);
+					buckets[i] = NULL;
+				}
+				buckets[i] = carry;
+				if (i == filled)
+					filled++;
+			}
+			carry = NULL;
+			for (i = 0; i < filled; i++)
+				if (buckets[i])
+					carry = merge_chains(buckets[i], carry, comp);
+			_head._next = carry;
+		};
+
+	//https://en.cppreference.com/w/cpp/container/forward_list
+	//Member types
+	public:
+		typedef T												value_type;
+		typedef T												&reference;
+		typedef T												*pointer;
+		typedef std::size_t										size_type;
+		typedef const T											&const_reference;
+		typedef const T											*const_pointer;
+		typedef Allocator										allocator_type;
+		typedef ft::ForwardIterator<T>							iterator;
+		typedef ft::ConstantForwardIterator<T>					const_iterator;
+		typedef typename ft::ForwardIterator<T>::difference_type	difference_type;
+
+		//MEMBER FUNCTIONS
+		//Default constructor. Constructs an empty container with a default-constructed allocator.
+		forward_list(void) :
+			_head(), _allocator(allocator_type()), _node_allocator(_allocator) {};
+
+		//Constructs an empty container with the given allocator alloc.
+		explicit forward_list(const allocator_type &allocator) :
+			_head(), _allocator(allocator), _node_allocator(_allocator) {};
+
+		//Constructs the container with count copies of elements with value value.
+		explicit forward_list(size_type count, const_reference value = T(),
+			const allocator_type &allocator = allocator_type()) :
+			_head(), _allocator(allocator), _node_allocator(_allocator) {
+				insert_after(before_begin(), count, value);
+		};
+
+		//Constructs the container with the contents of the range [first, last).
+		template <class InputIt>
+		forward_list(InputIt first, InputIt last, const allocator_type &allocator = allocator_type()) :
+			_head(), _allocator(allocator), _node_allocator(_allocator) {
+				insert_after(before_begin(), first, last);
+		};
+
+		//Copy constructor. Constructs the container with the copy of the contents of other
+		forward_list(const forward_list &copy) :
+			ForwardCount<Counted>(), _head(), _allocator(copy._allocator), _node_allocator(_allocator) {
+				insert_after(before_begin(), copy.begin(), copy.end());
+		};
+
+		//Destructor: releases every node
+		~forward_list(void) {
+			clear();
+		};
+
+		//Replaces content of one container to another
+		forward_list&			operator=(const forward_list &other) {
+			if (this != &other) {
+				clear();
+				_allocator = other._allocator;
+				_node_allocator = node_allocator(_allocator);
+				insert_after(before_begin(), other.begin(), other.end());
+			}
+			return (*this);
+		};
+
+		//Replaces the contents with count copies of value
+		void					assign(size_type count, const_reference value) {
+			clear();
+			insert_after(before_begin(), count, value);
+		};
+
+		//Replaces the contents with count copies of value (in case of problems with size_t)
+		void					assign(int count, const_reference value) {
+			clear();
+			if (count > 0)
+				insert_after(before_begin(), static_cast<size_type>(count), value);
+		};
+
+		//Replaces the contents with copies of those in the range [first, last)
+		template <class InputIt>
+		void					assign(InputIt first, InputIt last) {
+			clear();
+			insert_after(before_begin(), first, last);
+		};
+
+		allocator_type			get_allocator(void) const {
+			return (_allocator);
+		};
+
+		//ELEMENT ACCESS METHODS
+		reference				front(void) {
+			return (content(_head._next));
+		};
+
+		const_reference			front(void) const {
+			return (content(_head._next));
+		};
+
+		//ITERATORS METHODS
+		//Iterator to the element before the first one: the position of the head itself
+		iterator				before_begin(void) {
+			return (iterator(&_head));
+		};
+
+		const_iterator			before_begin(void) const {
+			return (const_iterator(const_cast<ForwardLink *>(&_head)));
+		};
+
+		iterator				begin(void) {
+			return (iterator(_head._next));
+		};
+
+		const_iterator			begin(void) const {
+			return (const_iterator(_head._next));
+		};
+
+		iterator				end(void) {
+			return (iterator(NULL));
+		};
+
+		const_iterator			end(void) const {
+			return (const_iterator(NULL));
+		};
+
+		//CAPACITY: getting container size
+		bool					empty(void) const {
+			return (_head._next == NULL);
+		};
+
+		//Constant time when Counted, linear otherwise
+		size_type				size(void) const {
+			if (Counted)
+				return (this->counted());
+			return (distance(_head._next, NULL));
+		};
+
+		size_type				max_size(void) const {
+			return (std::numeric_limits<size_type>::max() / sizeof(node));
+		};
+
+		//MODIFIERS: work with container elements
+		void					clear(void) {
+			release_nodes(_head._next);
+			_head._next = NULL;
+			this->count_clear();
+		};
+
+		//Inserts value after pos, returns iterator to the inserted element
+		iterator				insert_after(iterator pos, const_reference value) {
+			return (iterator(link_after(pos.get_list(), create_node(value))));
+		};
+
+		/*
+		** Inserts count copies of value after pos, returns iterator to the last inserted element.
+		** The nodes are chained off to the side first and linked with one splice:
+		** if a copy throws, the chain is released and the list is left unchanged.
+		*/
+		iterator				insert_after(iterator pos, size_type count, const_reference value) {
+			ForwardLink	*head = NULL;
+			ForwardLink	*tail = NULL;
+			size_type	added;
+
+			try {
+				for (added = 0; added < count; added++)
+					append_to_chain(head, tail, value);
+			}
+			catch (...) {
+				release_nodes(head);
+				throw ;
+			}
+			if (!head)
+				return (pos);
+			return (iterator(link_chain_after(pos.get_list(), head, tail, count)));
+		};
+
+		iterator				insert_after(iterator pos, int count, const_reference value) {
+			if (count > 0)
+				return (insert_after(pos, static_cast<size_type>(count), value));
+			return (pos);
+		};
+
+		//Inserts elements from range [first, last) after pos, all or nothing (see above)
+		template <class InputIt>
+		iterator				insert_after(iterator pos, InputIt first, InputIt last) {
+			ForwardLink	*head = NULL;
+			ForwardLink	*tail = NULL;
+			size_type	count = 0;
+
+			try {
+				for (; first != last; ++first) {
+					append_to_chain(head, tail, *first);
+					count++;
+				}
+			}
+			catch (...) {
+				release_nodes(head);
+				throw ;
+			}
+			if (!head)
+				return (pos);
+			return (iterator(link_chain_after(pos.get_list(), head, tail, count)));
+		};
+
+		//Removes the element following pos, returns iterator to the element after the erased one
+		iterator				erase_after(iterator pos) {
+			destroy_node(unlink_after(pos.get_list(), NULL));
+			return (iterator(pos.get_list()->_next));
+		};
+
+		//Removes the elements in the open range (first, last), returns last
+		iterator				erase_after(iterator first, iterator last) {
+			ForwardLink	*released = NULL;
+
+			while (first.get_list()->_next != last.get_list())
+				released = unlink_after(first.get_list(), released);
+			release_nodes(released);
+			return (last);
+		};
+
+		//Prepends the given element value to the beginning of the container.
+		void					push_front(const_reference value) {
+			link_after(&_head, create_node(value));
+		};
+
+		//Removes the first element of the container. UB on empty list
+		void					pop_front(void) {
+			if (_head._next)
+				destroy_node(unlink_after(&_head, NULL));
+		};
+
+		//Resizes the container to contain count elements.
+		void					resize(size_type count, value_type value = T()) {
+			ForwardLink	*last = &_head;
+
+			while (count && last->_next) {
+				last = last->_next;
+				count--;
+			}
+			if (count)
+				insert_after(iterator(last), count, value);
+			else
+				erase_after(iterator(last), end());
+		};
+
+		//Exchanges the contents of the container with those of other: only the head links move.
+		void					swap(forward_list &other) {
+			ForwardLink		*head = _head._next;
+			Allocator		allocator = _allocator;
+			node_allocator	nodes = _node_allocator;
+
+			//Nodes go back to the allocator they came from: both allocators follow them
+			_head._next = other._head._next;
+			other._head._next = head;
+			this->count_swap(other);
+			_allocator = other._allocator;
+			other._allocator = allocator;
+			_node_allocator = other._node_allocator;
+			other._node_allocator = nodes;
+		};
+
+		//OPERATIONS
+		//Merges two sorted lists into one by relinking, other becomes empty.
+		void					merge(forward_list &other) {
+			merge(other, less_than());
+		};
+
+		template <class Compare>
+		void					merge(forward_list &other, Compare comp) {
+			if ((this != &other) && !other.empty() && !shares_nodes(other)) {
+				forward_list	copied(other.begin(), other.end(), _allocator);
+
+				merge(copied, comp);
+				other.clear();
+			}
+			else if ((this != &other) && !other.empty()) {
+				_head._next = merge_chains(_head._next, other._head._next, comp);
+				this->count_take(other);
+				other._head._next = NULL;
+			}
+		};
+
+		/*
+		** Transfers all elements from other into *this after pos. Linear in the size of other.
+		** If the allocators differ, nodes of one cannot be freed by the other:
+		** the elements are copied instead and erased from other (here and below).
+		*/
+		void					splice_after(iterator pos, forward_list &other) {
+			if ((this != &other) && !other.empty() && !shares_nodes(other)) {
+				insert_after(pos, other.begin(), other.end());
+				other.clear();
+			}
+			else if ((this != &other) && !other.empty()) {
+				ForwardLink	*tail = other._head._next;
+
+				while (tail->_next)
+					tail = tail->_next;
+				tail->_next = pos.get_list()->_next;
+				pos.get_list()->_next = other._head._next;
+				this->count_take(other);
+				other._head._next = NULL;
+			}
+		};
+
+		//Transfers the element following it from other into *this after pos. Constant time.
+		void					splice_after(iterator pos, forward_list &other, iterator it) {
+			ForwardLink	*moved = it.get_list()->_next;
+
+			if ((pos == it) || (pos.get_list() == moved))
+				return ;
+			if (!shares_nodes(other)) {
+				insert_after(pos, content(moved));
+				other.erase_after(it);
+				return ;
+			}
+			it.get_list()->_next = moved->_next;
+			link_after(pos.get_list(), moved);
+			other.count_remove(1);
+		};
+
+		/*
+		** Transfers the elements in the open range (first, last) from other into *this after pos.
+		** Linear in the range length. UB if pos is an iterator in the range (first,last).
+		*/
+		void					splice_after(iterator pos, forward_list &other,
+			iterator first, iterator last) {
+			ForwardLink	*tail = first.get_list();
+			std::size_t	count = 0;
+
+			if (tail->_next == last.get_list())
+				return ;
+			if (!shares_nodes(other)) {
+				insert_after(pos, iterator(tail->_next), last);
+				other.erase_after(first, last);
+				return ;
+			}
+			while (tail->_next != last.get_list()) {
+				tail = tail->_next;
+				count++;
+			}
+			tail->_next = pos.get_list()->_next;
+			pos.get_list()->_next = first.get_list()->_next;
+			first.get_list()->_next = last.get_list();
+			if (this != &other) {
+				this->count_add(count);
+				other.count_remove(count);
+			}
+		};
+
+		//Removes all elements that are equal to value.
+		void					remove(const_reference value) {
+			ForwardLink	*current = &_head;
+			ForwardLink	*released = NULL;
+
+			while (current->_next) {
+				if (content(current->_next) == value)
+					released = unlink_after(current, released);
+				else
+					current = current->_next;
+			}
+			release_nodes(released);
+		};
+
+		//Removes all elements for which predicate p returns true.
+		template <class UnaryPredicate>
+		void					remove_if(UnaryPredicate p) {
+			ForwardLink	*current = &_head;
+			ForwardLink	*released = NULL;
+
+			while (current->_next) {
+				if (p(content(current->_next)))
+					released = unlink_after(current, released);
+				else
+					current = current->_next;
+			}
+			release_nodes(released);
+		};
+
+		//Reverses the order of the elements by relinking them.
+		void					reverse(void) {
+			ForwardLink	*reversed = NULL;
+			ForwardLink	*current = _head._next;
+			ForwardLink	*next;
+
+			while (current) {
+				next = current->_next;
+				current->_next = reversed;
+				reversed = current;
+				current = next;
+			}
+			_head._next = reversed;
+		};
+
+		//Removes all consecutive duplicate elements from the container.
+		void					unique(void) {
+			unique(equal_to());
+		};
+
+		//Removes consecutive elements for which p(kept, current) returns true.
+		template <class BinaryPredicate>
+		void					unique(BinaryPredicate p) {
+			ForwardLink	*kept = _head._next;
+			ForwardLink	*released = NULL;
+
+			if (!kept)
+				return ;
+			while (kept->_next) {
+				if (p(content(kept), content(kept->_next)))
+					released = unlink_after(kept, released);
+				else
+					kept = kept->_next;
+			}
+			release_nodes(released);
+		};
+
+		//Sorts the elements in ascending order, order of equal elements is preserved.
+		void					sort(void) {
+			sort_chain(less_than());
+		};
+
+		template <class Compare>
+		void					sort(Compare comp) {
+			sort_chain(comp);
+		};
+	};
+
+	//NON-MEMBER FUNCTIONS OVERLOAD
+	//Checks if the contents of lhs and rhs are equal
+	template <class T, class Alloc, bool Counted>
+	bool	operator==(const forward_list<T, Alloc, Counted> &lhs,
+		const forward_list<T, Alloc, Counted> &rhs) {
+		typename forward_list<T, Alloc, Counted>::const_iterator	lit = lhs.begin();
+		typename forward_list<T, Alloc, Counted>::const_iterator	rit = rhs.begin();
+
+		while ((lit != lhs.end()) && (rit != rhs.end())) {
+			if (!(*lit == *rit))
+				return (false);
+			++lit;
+			++rit;
+		}
+		return ((lit == lhs.end()) && (rit == rhs.end()));
+	};
+
+	template <class T, class Alloc, bool Counted>
+	bool	operator!=(const forward_list<T, Alloc, Counted> &lhs,
+		const forward_list<T, Alloc, Counted> &rhs) {
+		return (!(lhs == rhs));
+	};
+
+	//Swaps the contents of lhs and rhs. Calls lhs.swap(rhs).
+	template <class T, class Alloc, bool Counted>
+	void	swap(forward_list<T, Alloc, Counted> &lhs, forward_list<T, Alloc, Counted> &rhs) {
+		lhs.swap(rhs);
+	};
+};
+
+#endif
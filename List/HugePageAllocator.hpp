@@ -0,0 +1,224 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HugePageAllocator.hpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mskinner <v.golskiy@ya.ru>                 +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/06/18 15:26:09 by mskinner          #+#    #+#             */
+/*   Updated: 2021/06/18 15:26:09 by mskinner         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Huge page allocator for big containers: requests of Threshold bytes and more
+** get a region of their own, mapped with mmap() on a huge page boundary and
+** advised with MADV_HUGEPAGE, smaller requests go to ::operator new.
+** + a vector of gigabytes is covered by a few thousand TLB entries instead of a million,
+** + a region can be bound to the NUMA node of the thread creating it;
+** - a large request is rounded up to whole huge pages,
+** - every large allocation and deallocation is a system call.
+** Advice and binding are hints: where the kernel lacks them, regions are plain mappings.
+** Only standard and POSIX headers are included, so every ft container directory may include this file.
+**
+** ft::vector<long, ft::HugePageAllocator<long> >	samples((ft::HugePageAllocator<long>(true)));
+*/
+
+#pragma once
+
+#ifndef _HUGE_PAGE_ALLOCATOR_HPP_
+# define _HUGE_PAGE_ALLOCATOR_HPP_
+
+# include <cstddef>
+# include <limits>
+# include <new>
+# include <sys/mman.h>
+# include <unistd.h>
+# ifdef __linux__
+#  include <sys/syscall.h>
+# endif
+
+namespace ft
+{
+	class HugePages
+	{
+	private:
+		//MPOL_PREFERRED of <numaif.h>: the node is tried first, other nodes serve when it is full
+		static const int	preferred_policy = 1;
+
+		HugePages(void);
+
+		static std::size_t	round_up(std::size_t bytes) {
+			return ((bytes + page_size - 1) & ~(page_size - 1));
+		};
+
+	public:
+		//Size of a transparent huge page on x86-64 and most aarch64 kernels
+		static const std::size_t	page_size = 2 * 1024 * 1024;
+
+		//Maps bytes rounded up to whole huge pages on a huge page boundary, NULL when out of memory
+		static void*	map(std::size_t bytes, bool numa_local) {
+			std::size_t	length = round_up(bytes);
+			char		*raw;
+			char		*region;
+			std::size_t	head;
+
+			raw = static_cast<char *>(mmap(NULL, length + page_size, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+			if (raw == MAP_FAILED)
+				return (NULL);
+			region = reinterpret_cast<char *>(
+				(reinterpret_cast<std::size_t>(raw) + page_size - 1) & ~(page_size - 1));
+			head = region - raw;
+			if (head)
+				munmap(raw, head);
+			if (page_size - head)
+				munmap(region + length, page_size - head);
+# ifdef MADV_HUGEPAGE
+			madvise(region, length, MADV_HUGEPAGE);
+# endif
+			if (numa_local)
+				bind_local(region, length);
+			return (region);
+		};
+
+		//bytes must be the size given to map()
+		static void		unmap(void *region, std::size_t bytes) {
+			munmap(region, round_up(bytes));
+		};
+
+		//NUMA node of the CPU running the calling thread, -1 where unknown
+		static int		local_node(void) {
+# if defined(__linux__) && defined(SYS_getcpu)
+			unsigned int	cpu;
+			unsigned int	node;
+
+			if (!syscall(SYS_getcpu, &cpu, &node, NULL))
+				return (static_cast<int>(node));
+# endif
+			return (-1);
+		};
+
+		//Asks the kernel to place the pages of a region on the local node, false where it cannot
+		static bool		bind_local(void *region, std::size_t length) {
+# if defined(__linux__) && defined(SYS_mbind)
+			int				node = local_node();
+			unsigned long	mask;
+
+			if ((node < 0) || (node >= static_cast<int>(sizeof(mask) * 8)))
+				return (false);
+			mask = 1UL << node;
+			return (!syscall(SYS_mbind, region, length, preferred_policy, &mask, sizeof(mask) * 8, 0));
+# else
+			(void)region;
+			(void)length;
+			return (false);
+# endif
+		};
+	};
+
+	/*
+	** Stateless but for the NUMA flag: memory from one instance may be given back
+	** to any other, the size of a request tells where it came from.
+	** Copies and rebound copies (conv<U>::other) keep the NUMA flag.
+	*/
+	template <typename T, std::size_t Threshold = HugePages::page_size / 2>
+	class HugePageAllocator
+	{
+	private:
+		bool	_numa_local;
+
+	//Member types
+	public:
+		typedef T											value_type;
+		typedef T											&reference;
+		typedef T											*pointer;
+		typedef const T										&const_reference;
+		typedef const T										*const_pointer;
+		typedef std::size_t									size_type;
+		typedef std::ptrdiff_t								difference_type;
+
+		template<typename U>
+		struct conv {
+			typedef HugePageAllocator<U, Threshold> other;
+		};
+
+		template<typename U>
+		struct rebind {
+			typedef HugePageAllocator<U, Threshold> other;
+		};
+
+		//numa_local: large regions prefer the NUMA node of the allocating thread
+		explicit HugePageAllocator(bool numa_local = false) : _numa_local(numa_local) {};
+		~HugePageAllocator() {};
+		HugePageAllocator(const HugePageAllocator &copy) : _numa_local(copy._numa_local) {};
+
+		template<typename U>
+		HugePageAllocator(const HugePageAllocator<U, Threshold> &copy) : _numa_local(copy.numa_local()) {};
+
+		HugePageAllocator&	operator=(const HugePageAllocator &other) {
+			_numa_local = other._numa_local;
+			return (*this);
+		};
+
+		bool			numa_local(void) const {
+			return (_numa_local);
+		};
+
+		//Getting located memory pointers
+		pointer			address(reference ref) const {
+			return (&ref);
+		};
+
+		const_pointer	address(const_reference ref) const {
+			return (&ref);
+		};
+
+		pointer			allocate(size_type cnt, const void * = 0) {
+			void	*region;
+
+			if (cnt > max_size())
+				throw std::bad_alloc();
+			if (cnt * sizeof(T) < Threshold)
+				return (static_cast<pointer>(::operator new(cnt * sizeof(T))));
+			region = HugePages::map(cnt * sizeof(T), _numa_local);
+			if (!region)
+				throw std::bad_alloc();
+			return (static_cast<pointer>(region));
+		};
+
+		//cnt must be the value passed to allocate(), as for ft::Allocator
+		void			deallocate(pointer p, size_type cnt) {
+			if (cnt * sizeof(T) < Threshold)
+				::operator delete(p);
+			else
+				HugePages::unmap(p, cnt * sizeof(T));
+		};
+
+		size_type		max_size() const {
+			return (std::numeric_limits<size_type>::max() / sizeof(value_type));
+		};
+
+		void			construct(pointer p, const_reference val) {
+			new(p) T(val);
+		};
+
+		void			destroy(pointer p) {
+			p->~T();
+		};
+	};
+
+	//Any huge page allocator can give back memory of another: always true
+	template <class T1, class T2, std::size_t Threshold>
+	bool			operator==(const HugePageAllocator<T1, Threshold> &, const HugePageAllocator<T2, Threshold> &) {
+		return (true);
+	};
+
+	//Always false
+	template <class T1, class T2, std::size_t Threshold>
+	bool			operator!=(const HugePageAllocator<T1, Threshold> &, const HugePageAllocator<T2, Threshold> &) {
+		return (false);
+	};
+}
+
+#endif
@@ -0,0 +1,304 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   IntrusiveList.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mskinner <v.golskiy@ya.ru>                 +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/06/08 11:04:17 by mskinner          #+#    #+#             */
+/*   Updated: 2021/06/08 11:04:17 by mskinner         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Intrusive lists link objects owned by the caller through a ListHook member of T:
+** + no allocation and no copy on insertion, the element itself is the node,
+** + constant time erase of an element known by reference, no search needed,
+** + constant time iterator from element and splice between lists;
+** - the list does not own its elements: they must outlive their membership
+** and can be linked in only one list per hook member at a time,
+** - elements are unlinked, never destroyed, by erase, clear and the destructor.
+**
+** struct Timer { int deadline; ft::ListHook hook; };
+** ft::intrusive_list<Timer, &Timer::hook> timers;
+*/
+
+#pragma once
+
+#ifndef _INTRUSIVE_LIST_HPP_
+# define _INTRUSIVE_LIST_HPP_
+
+# include "Node.hpp"
+# include "Iterator.hpp"
+
+namespace ft
+{
+	template <typename T, ListHook T::*Hook>
+	class intrusive_list
+	{
+	private:
+		//Sentinel links: _head._next is the first element hook, _head._previous the last one
+		ListHook	_head;
+		std::size_t	_size;
+
+		//Elements belong to the caller, lists are neither copied nor assigned
+		intrusive_list(const intrusive_list &);
+		intrusive_list&	operator=(const intrusive_list &);
+
+		static ListHook*	hook(T &value) {
+			return (&(value.*Hook));
+		};
+
+		static const ListHook*	hook(const T &value) {
+			return (&(value.*Hook));
+		};
+
+		void	link_before(ListHook *pos, ListHook *add) {
+			add->_next = pos;
+			add->_previous = pos->_previous;
+			pos->_previous->_next = add;
+			pos->_previous = add;
+			_size++;
+		};
+
+		void	unlink(ListHook *old) {
+			old->_previous->_next = old->_next;
+			old->_next->_previous = old->_previous;
+			old->_previous = NULL;
+			old->_next = NULL;
+			_size--;
+		};
+
+		//Relinks the chain [first, last) before pos, whatever list it belongs to
+		static void	transfer(ListHook *pos, ListHook *first, ListHook *last) {
+			ListHook	*tail = last->_previous;
+
+			first->_previous->_next = last;
+			last->_previous = first->_previous;
+			first->_previous = pos->_previous;
+			tail->_next = pos;
+			pos->_previous->_next = first;
+			pos->_previous = tail;
+		};
+
+	//Member types
+	public:
+		typedef T												value_type;
+		typedef T												&reference;
+		typedef T												*pointer;
+		typedef std::size_t										size_type;
+		typedef const T											&const_reference;
+		typedef const T											*const_pointer;
+		typedef ft::IntrusiveIterator<T, Hook>					iterator;
+		typedef ft::IntrusiveReverseIterator<T, Hook>			reverse_iterator;
+		typedef ft::IntrusiveConstantIterator<T, Hook>			const_iterator;
+		typedef ft::IntrusiveConstantReverseIterator<T, Hook>	const_reverse_iterator;
+		typedef typename iterator::difference_type				difference_type;
+
+		//MEMBER FUNCTIONS
+		//Constructs an empty list
+		intrusive_list(void) : _head(), _size(0) {
+			_head._next = &_head;
+			_head._previous = &_head;
+		};
+
+		//Unlinks every element, elements themselves are left untouched
+		~intrusive_list(void) {
+			clear();
+		};
+
+		//ELEMENT ACCESS METHODS
+		reference				front(void) {
+			return (*ListHook::owner<T, Hook>(_head._next));
+		};
+
+		const_reference			front(void) const {
+			return (*ListHook::owner<T, Hook>(_head._next));
+		};
+
+		reference				back(void) {
+			return (*ListHook::owner<T, Hook>(_head._previous));
+		};
+
+		const_reference			back(void) const {
+			return (*ListHook::owner<T, Hook>(_head._previous));
+		};
+
+		//ITERATORS METHODS
+		iterator				begin(void) {
+			return (iterator(_head._next));
+		};
+
+		iterator				end(void) {
+			return (iterator(&_head));
+		};
+
+		const_iterator			begin(void) const {
+			return (const_iterator(_head._next));
+		};
+
+		const_iterator			end(void) const {
+			return (const_iterator(const_cast<ListHook *>(&_head)));
+		};
+
+		reverse_iterator		rbegin(void) {
+			return (reverse_iterator(_head._previous));
+		};
+
+		reverse_iterator		rend(void) {
+			return (reverse_iterator(&_head));
+		};
+
+		const_reverse_iterator	rbegin(void) const {
+			return (const_reverse_iterator(_head._previous));
+		};
+
+		const_reverse_iterator	rend(void) const {
+			return (const_reverse_iterator(const_cast<ListHook *>(&_head)));
+		};
+
+		//Returns iterator pointing to value, which must be linked in this list. Constant time.
+		iterator				iterator_to(T &value) {
+			return (iterator(hook(value)));
+		};
+
+		const_iterator			iterator_to(const T &value) const {
+			return (const_iterator(const_cast<ListHook *>(hook(value))));
+		};
+
+		//CAPACITY: getting container size
+		bool					empty(void) const {
+			return (_size == 0);
+		};
+
+		size_type				size(void) const {
+			return (_size);
+		};
+
+		//MODIFIERS: work with container elements
+		//Unlinks all elements, their hooks are reset so they can be linked again
+		void					clear(void) {
+			while (_size)
+				unlink(_head._next);
+		};
+
+		//Links value before pos, value must not be linked in any list through Hook
+		iterator				insert(iterator pos, T &value) {
+			link_before(pos.get_list(), hook(value));
+			return (iterator(hook(value)));
+		};
+
+		//Unlinks the element at pos (the end() iterator cannot be used as a value for pos)
+		iterator				erase(iterator pos) {
+			ListHook	*next = pos.get_list()->_next;
+
+			unlink(pos.get_list());
+			return (iterator(next));
+		};
+
+		//Unlinks value, which must be linked in this list. Constant time, no search.
+		iterator				erase(T &value) {
+			return (erase(iterator_to(value)));
+		};
+
+		//Unlinks the elements in the range [first, last).
+		iterator				erase(iterator first, iterator last) {
+			while (first != last)
+				first = erase(first);
+			return (last);
+		};
+
+		void					push_back(T &value) {
+			link_before(&_head, hook(value));
+		};
+
+		//Unlinks the last element of the container. UB on empty list
+		void					pop_back(void) {
+			if (_size)
+				unlink(_head._previous);
+		};
+
+		void					push_front(T &value) {
+			link_before(_head._next, hook(value));
+		};
+
+		//Unlinks the first element of the container. UB on empty list
+		void					pop_front(void) {
+			if (_size)
+				unlink(_head._next);
+		};
+
+		//Exchanges the elements of the two lists, only the sentinels are relinked
+		void					swap(intrusive_list &other) {
+			intrusive_list	tmp;
+
+			tmp.splice(tmp.end(), *this);
+			splice(end(), other);
+			other.splice(other.end(), tmp);
+		};
+
+		//OPERATIONS
+		//Transfers all elements from other into *this before pos. Constant time.
+		void					splice(iterator pos, intrusive_list &other) {
+			if ((this != &other) && !other.empty()) {
+				transfer(pos.get_list(), other._head._next, &other._head);
+				_size += other._size;
+				other._size = 0;
+			}
+		};
+
+		//Transfers the element pointed to by it from other into *this before pos. Constant time.
+		void					splice(iterator pos, intrusive_list &other, iterator it) {
+			ListHook	*moved = it.get_list();
+
+			if ((pos.get_list() == moved) || (pos.get_list() == moved->_next))
+				return ;
+			transfer(pos.get_list(), moved, moved->_next);
+			other._size--;
+			_size++;
+		};
+
+		/*
+		** Transfers the elements in the range [first, last) from other into *this before pos.
+		** Linear in the range length when other is another list (sizes have to be updated).
+		** UB if pos is an iterator in the range [first,last).
+		*/
+		void					splice(iterator pos, intrusive_list &other,
+			iterator first, iterator last) {
+			if (first == last)
+				return ;
+			if (this != &other) {
+				size_type	count = 0;
+				iterator	it;
+
+				for (it = first; it != last; ++it)
+					count++;
+				other._size -= count;
+				_size += count;
+			}
+			transfer(pos.get_list(), first.get_list(), last.get_list());
+		};
+
+		//Unlinks all elements for which predicate p returns true.
+		template <class UnaryPredicate>
+		void					remove_if(UnaryPredicate p) {
+			ListHook	*current = _head._next;
+			ListHook	*next;
+
+			while (current != &_head) {
+				next = current->_next;
+				if (p(*ListHook::owner<T, Hook>(current)))
+					unlink(current);
+				current = next;
+			}
+		};
+	};
+
+	//Swaps the elements of lhs and rhs. Calls lhs.swap(rhs).
+	template <typename T, ListHook T::*Hook>
+	void	swap(intrusive_list<T, Hook> &lhs, intrusive_list<T, Hook> &rhs) {
+		lhs.swap(rhs);
+	};
+};
+
+#endif
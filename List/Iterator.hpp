@@ -270,6 +270,583 @@ namespace ft
 			return (postfix);
 		};
 	};
+
+	//Iterators of ft::forward_list: single direction, they walk ForwardLink::_next
+	template < typename T, class Category = forward_iterator_tag >
+	class ForwardIterator
+	{
+	protected:
+		ForwardLink	*_list;
+
+	public:
+		typedef T				value_type;
+		typedef std::ptrdiff_t	difference_type;
+		typedef T				&reference;
+		typedef T				*pointer;
+		typedef Category		iterator_category;
+
+		//Coplien form
+		ForwardIterator(void): _list(NULL) {};
+		explicit ForwardIterator(ForwardLink *list): _list(list) {};
+		ForwardIterator(const ForwardIterator &copy): _list(copy._list) {};
+		virtual ~ForwardIterator() {};
+		ForwardIterator&	operator=(const ForwardIterator &other) {
+			_list = other._list;
+			return (*this);
+		};
+
+		//Returns link address
+		ForwardLink*	get_list(void) const {
+			return (_list);
+		};
+
+		//Operators
+		bool		operator==(const ForwardIterator &other) const {
+			return (_list == other._list);
+		};
+
+		bool		operator!=(const ForwardIterator &other) const {
+			return (_list != other._list);
+		};
+
+		T&	operator*(void) const {
+			return (static_cast<ForwardNode<T> *>(_list)->_content);
+		};
+
+		T*	operator->(void) const {
+			return (&static_cast<ForwardNode<T> *>(_list)->_content);
+		};
+
+		//++it
+		ForwardIterator&	operator++(void) {
+			_list = _list->_next;
+			return (*this);
+		};
+
+		//it++
+		ForwardIterator	operator++(int) {
+			ForwardIterator	postfix(*this);
+
+			_list = _list->_next;
+			return (postfix);
+		};
+	};
+
+	template < typename T, class Category = forward_iterator_tag >
+	class ConstantForwardIterator : public ForwardIterator<T>
+	{
+	public:
+		typedef const T	&const_reference;
+		typedef const T	*const_pointer;
+
+		//Coplien form
+		ConstantForwardIterator(void): ForwardIterator<T>() {};
+		explicit ConstantForwardIterator(ForwardLink *list): ForwardIterator<T>(list) {};
+		ConstantForwardIterator(const ConstantForwardIterator &copy): ForwardIterator<T>(copy) {};
+		virtual ~ConstantForwardIterator() {};
+		ConstantForwardIterator&	operator=(const ConstantForwardIterator &other) {
+			this->_list = other._list;
+			return (*this);
+		};
+
+		//Operators
+		const_reference			operator*(void) const {
+			return (static_cast<ForwardNode<T> *>(this->_list)->_content);
+		};
+
+		const_pointer			operator->(void) const {
+			return (&static_cast<ForwardNode<T> *>(this->_list)->_content);
+		};
+
+		//++it
+		ConstantForwardIterator&	operator++(void) {
+			this->_list = this->_list->_next;
+			return (*this);
+		};
+
+		//it++
+		ConstantForwardIterator	operator++(int) {
+			ConstantForwardIterator	postfix(*this);
+
+			this->_list = this->_list->_next;
+			return (postfix);
+		};
+	};
+
+	/*
+	** Iterators of ft::unrolled_list: a position is a block plus an index inside it.
+	** Stepping past the last element of a block jumps to the first element of the next one,
+	** the sentinel block (no elements) stands for end() and rend().
+	*/
+	template < typename T, std::size_t K, class Category = bidirectional_iterator_tag >
+	class UnrolledIterator
+	{
+	protected:
+		UnrolledNode<T, K>	*_node;
+		std::size_t			_index;
+
+		void	forward(void) {
+			if (++_index >= _node->_count) {
+				_node = _node->_next;
+				_index = 0;
+			}
+		};
+
+		void	backward(void) {
+			if (!_index) {
+				_node = _node->_previous;
+				_index = _node->_count ? _node->_count - 1 : 0;
+			}
+			else
+				_index--;
+		};
+
+	public:
+		typedef T				value_type;
+		typedef std::ptrdiff_t	difference_type;
+		typedef T				&reference;
+		typedef T				*pointer;
+		typedef Category		iterator_category;
+
+		//Coplien form
+		UnrolledIterator(void): _node(NULL), _index(0) {};
+		UnrolledIterator(UnrolledNode<T, K> *node, std::size_t index): _node(node), _index(index) {};
+		UnrolledIterator(const UnrolledIterator &copy): _node(copy._node), _index(copy._index) {};
+		virtual ~UnrolledIterator() {};
+		UnrolledIterator&	operator=(const UnrolledIterator &other) {
+			_node = other._node;
+			_index = other._index;
+			return (*this);
+		};
+
+		//Returns block address and position inside the block
+		UnrolledNode<T, K>*	get_node(void) const {
+			return (_node);
+		};
+
+		std::size_t			get_index(void) const {
+			return (_index);
+		};
+
+		//Operators
+		bool		operator==(const UnrolledIterator &other) const {
+			return ((_node == other._node) && (_index == other._index));
+		};
+
+		bool		operator!=(const UnrolledIterator &other) const {
+			return (!(*this == other));
+		};
+
+		T&	operator*(void) const {
+			return (_node->content()[_index]);
+		};
+
+		T*	operator->(void) const {
+			return (_node->content() + _index);
+		};
+
+		//++it
+		UnrolledIterator&	operator++(void) {
+			forward();
+			return (*this);
+		};
+
+		UnrolledIterator&	operator--(void) {
+			backward();
+			return (*this);
+		};
+
+		//it++
+		UnrolledIterator	operator++(int) {
+			UnrolledIterator	postfix(*this);
+
+			forward();
+			return (postfix);
+		};
+
+		UnrolledIterator	operator--(int) {
+			UnrolledIterator	postfix(*this);
+
+			backward();
+			return (postfix);
+		};
+	};
+
+	template < typename T, std::size_t K, class Category = bidirectional_iterator_tag >
+	class UnrolledReverseIterator : public UnrolledIterator<T, K>
+	{
+	public:
+		//Coplien form
+		UnrolledReverseIterator(void): UnrolledIterator<T, K>() {};
+		UnrolledReverseIterator(UnrolledNode<T, K> *node, std::size_t index):
+			UnrolledIterator<T, K>(node, index) {};
+		UnrolledReverseIterator(const UnrolledReverseIterator &copy): UnrolledIterator<T, K>(copy) {};
+		virtual ~UnrolledReverseIterator() {};
+		UnrolledReverseIterator&	operator=(const UnrolledReverseIterator &other) {
+			UnrolledIterator<T, K>::operator=(other);
+			return (*this);
+		};
+
+		//Operators
+		//++it
+		UnrolledReverseIterator&	operator++(void) {
+			this->backward();
+			return (*this);
+		};
+
+		UnrolledReverseIterator&	operator--(void) {
+			this->forward();
+			return (*this);
+		};
+
+		//it++
+		UnrolledReverseIterator	operator++(int) {
+			UnrolledReverseIterator	postfix(*this);
+
+			this->backward();
+			return (postfix);
+		};
+
+		UnrolledReverseIterator	operator--(int) {
+			UnrolledReverseIterator	postfix(*this);
+
+			this->forward();
+			return (postfix);
+		};
+	};
+
+	template < typename T, std::size_t K, class Category = bidirectional_iterator_tag >
+	class UnrolledConstantIterator : public UnrolledIterator<T, K>
+	{
+	public:
+		typedef const T	&const_reference;
+		typedef const T	*const_pointer;
+
+		//Coplien form
+		UnrolledConstantIterator(void): UnrolledIterator<T, K>() {};
+		UnrolledConstantIterator(UnrolledNode<T, K> *node, std::size_t index):
+			UnrolledIterator<T, K>(node, index) {};
+		UnrolledConstantIterator(const UnrolledConstantIterator &copy): UnrolledIterator<T, K>(copy) {};
+		virtual ~UnrolledConstantIterator() {};
+		UnrolledConstantIterator&	operator=(const UnrolledConstantIterator &other) {
+			UnrolledIterator<T, K>::operator=(other);
+			return (*this);
+		};
+
+		//Operators
+		const_reference		operator*(void) const {
+			return (this->_node->content()[this->_index]);
+		};
+
+		const_pointer		operator->(void) const {
+			return (this->_node->content() + this->_index);
+		};
+
+		//++it
+		UnrolledConstantIterator&	operator++(void) {
+			this->forward();
+			return (*this);
+		};
+
+		UnrolledConstantIterator&	operator--(void) {
+			this->backward();
+			return (*this);
+		};
+
+		//it++
+		UnrolledConstantIterator	operator++(int) {
+			UnrolledConstantIterator	postfix(*this);
+
+			this->forward();
+			return (postfix);
+		};
+
+		UnrolledConstantIterator	operator--(int) {
+			UnrolledConstantIterator	postfix(*this);
+
+			this->backward();
+			return (postfix);
+		};
+	};
+
+	template < typename T, std::size_t K, class Category = bidirectional_iterator_tag >
+	class UnrolledConstantReverseIterator : public UnrolledIterator<T, K>
+	{
+	public:
+		typedef const T	&const_reference;
+		typedef const T	*const_pointer;
+
+		//Coplien form
+		UnrolledConstantReverseIterator(void): UnrolledIterator<T, K>() {};
+		UnrolledConstantReverseIterator(UnrolledNode<T, K> *node, std::size_t index):
+			UnrolledIterator<T, K>(node, index) {};
+		UnrolledConstantReverseIterator(const UnrolledConstantReverseIterator &copy):
+			UnrolledIterator<T, K>(copy) {};
+		virtual ~UnrolledConstantReverseIterator() {};
+		UnrolledConstantReverseIterator&	operator=(const UnrolledConstantReverseIterator &other) {
+			UnrolledIterator<T, K>::operator=(other);
+			return (*this);
+		};
+
+		//Operators
+		const_reference		operator*(void) const {
+			return (this->_node->content()[this->_index]);
+		};
+
+		const_pointer		operator->(void) const {
+			return (this->_node->content() + this->_index);
+		};
+
+		//++it
+		UnrolledConstantReverseIterator&	operator++(void) {
+			this->backward();
+			return (*this);
+		};
+
+		UnrolledConstantReverseIterator&	operator--(void) {
+			this->forward();
+			return (*this);
+		};
+
+		//it++
+		UnrolledConstantReverseIterator	operator++(int) {
+			UnrolledConstantReverseIterator	postfix(*this);
+
+			this->backward();
+			return (postfix);
+		};
+
+		UnrolledConstantReverseIterator	operator--(int) {
+			UnrolledConstantReverseIterator	postfix(*this);
+
+			this->forward();
+			return (postfix);
+		};
+	};
+
+	/*
+	** Iterators of ft::intrusive_list<T, Hook>: they walk the ListHook links embedded
+	** into the elements and give back the owning element on dereference.
+	*/
+	template < typename T, ListHook T::*Hook, class Category = bidirectional_iterator_tag >
+	class IntrusiveIterator
+	{
+	protected:
+		ListHook	*_list;
+
+	public:
+		typedef T				value_type;
+		typedef std::ptrdiff_t	difference_type;
+		typedef T				&reference;
+		typedef T				*pointer;
+		typedef Category		iterator_category;
+
+		//Coplien form
+		IntrusiveIterator(void): _list(NULL) {};
+		explicit IntrusiveIterator(ListHook *list): _list(list) {};
+		IntrusiveIterator(const IntrusiveIterator &copy): _list(copy._list) {};
+		virtual ~IntrusiveIterator() {};
+		IntrusiveIterator&	operator=(const IntrusiveIterator &other) {
+			_list = other._list;
+			return (*this);
+		};
+
+		//Returns hook address
+		ListHook*	get_list(void) const {
+			return (_list);
+		};
+
+		//Operators
+		bool		operator==(const IntrusiveIterator &other) const {
+			return (_list == other._list);
+		};
+
+		bool		operator!=(const IntrusiveIterator &other) const {
+			return (_list != other._list);
+		};
+
+		T&	operator*(void) const {
+			return (*ListHook::owner<T, Hook>(_list));
+		};
+
+		T*	operator->(void) const {
+			return (ListHook::owner<T, Hook>(_list));
+		};
+
+		//++it
+		IntrusiveIterator&	operator++(void) {
+			_list = _list->_next;
+			return (*this);
+		};
+
+		IntrusiveIterator&	operator--(void) {
+			_list = _list->_previous;
+			return (*this);
+		};
+
+		//it++
+		IntrusiveIterator	operator++(int) {
+			IntrusiveIterator	postfix(*this);
+
+			_list = _list->_next;
+			return (postfix);
+		};
+
+		IntrusiveIterator	operator--(int) {
+			IntrusiveIterator	postfix(*this);
+
+			_list = _list->_previous;
+			return (postfix);
+		};
+	};
+
+	template < typename T, ListHook T::*Hook, class Category = bidirectional_iterator_tag >
+	class IntrusiveReverseIterator : public IntrusiveIterator<T, Hook>
+	{
+	public:
+		//Coplien form
+		IntrusiveReverseIterator(void): IntrusiveIterator<T, Hook>() {};
+		explicit IntrusiveReverseIterator(ListHook *list): IntrusiveIterator<T, Hook>(list) {};
+		IntrusiveReverseIterator(const IntrusiveReverseIterator &copy): IntrusiveIterator<T, Hook>(copy) {};
+		virtual ~IntrusiveReverseIterator() {};
+		IntrusiveReverseIterator&	operator=(const IntrusiveReverseIterator &other) {
+			this->_list = other._list;
+			return (*this);
+		};
+
+		//Operators
+		//++it
+		IntrusiveReverseIterator&	operator++(void) {
+			this->_list = this->_list->_previous;
+			return (*this);
+		};
+
+		IntrusiveReverseIterator&	operator--(void) {
+			this->_list = this->_list->_next;
+			return (*this);
+		};
+
+		//it++
+		IntrusiveReverseIterator	operator++(int) {
+			IntrusiveReverseIterator	postfix(*this);
+
+			this->_list = this->_list->_previous;
+			return (postfix);
+		};
+
+		IntrusiveReverseIterator	operator--(int) {
+			IntrusiveReverseIterator	postfix(*this);
+
+			this->_list = this->_list->_next;
+			return (postfix);
+		};
+	};
+
+	template < typename T, ListHook T::*Hook, class Category = bidirectional_iterator_tag >
+	class IntrusiveConstantIterator : public IntrusiveIterator<T, Hook>
+	{
+	public:
+		typedef const T	&const_reference;
+		typedef const T	*const_pointer;
+
+		//Coplien form
+		IntrusiveConstantIterator(void): IntrusiveIterator<T, Hook>() {};
+		explicit IntrusiveConstantIterator(ListHook *list): IntrusiveIterator<T, Hook>(list) {};
+		IntrusiveConstantIterator(const IntrusiveConstantIterator &copy): IntrusiveIterator<T, Hook>(copy) {};
+		virtual ~IntrusiveConstantIterator() {};
+		IntrusiveConstantIterator&	operator=(const IntrusiveConstantIterator &other) {
+			this->_list = other._list;
+			return (*this);
+		};
+
+		//Operators
+		const_reference		operator*(void) const {
+			return (*ListHook::owner<T, Hook>(this->_list));
+		};
+
+		const_pointer		operator->(void) const {
+			return (ListHook::owner<T, Hook>(this->_list));
+		};
+
+		//++it
+		IntrusiveConstantIterator&	operator++(void) {
+			this->_list = this->_list->_next;
+			return (*this);
+		};
+
+		IntrusiveConstantIterator&	operator--(void) {
+			this->_list = this->_list->_previous;
+			return (*this);
+		};
+
+		//it++
+		IntrusiveConstantIterator	operator++(int) {
+			IntrusiveConstantIterator	postfix(*this);
+
+			this->_list = this->_list->_next;
+			return (postfix);
+		};
+
+		IntrusiveConstantIterator	operator--(int) {
+			IntrusiveConstantIterator	postfix(*this);
+
+			this->_list = this->_list->_previous;
+			return (postfix);
+		};
+	};
+
+	template < typename T, ListHook T::*Hook, class Category = bidirectional_iterator_tag >
+	class IntrusiveConstantReverseIterator : public IntrusiveIterator<T, Hook>
+	{
+	public:
+		typedef const T	&const_reference;
+		typedef const T	*const_pointer;
+
+		//Coplien form
+		IntrusiveConstantReverseIterator(void): IntrusiveIterator<T, Hook>() {};
+		explicit IntrusiveConstantReverseIterator(ListHook *list): IntrusiveIterator<T, Hook>(list) {};
+		IntrusiveConstantReverseIterator(const IntrusiveConstantReverseIterator &copy): IntrusiveIterator<T, Hook>(copy) {};
+		virtual ~IntrusiveConstantReverseIterator() {};
+		IntrusiveConstantReverseIterator&	operator=(const IntrusiveConstantReverseIterator &other) {
+			this->_list = other._list;
+			return (*this);
+		};
+
+		//Operators
+		const_reference		operator*(void) const {
+			return (*ListHook::owner<T, Hook>(this->_list));
+		};
+
+		const_pointer		operator->(void) const {
+			return (ListHook::owner<T, Hook>(this->_list));
+		};
+
+		//++it
+		IntrusiveConstantReverseIterator&	operator++(void) {
+			this->_list = this->_list->_previous;
+			return (*this);
+		};
+
+		IntrusiveConstantReverseIterator&	operator--(void) {
+			this->_list = this->_list->_next;
+			return (*this);
+		};
+
+		//it++
+		IntrusiveConstantReverseIterator	operator++(int) {
+			IntrusiveConstantReverseIterator	postfix(*this);
+
+			this->_list = this->_list->_previous;
+			return (postfix);
+		};
+
+		IntrusiveConstantReverseIterator	operator--(int) {
+			IntrusiveConstantReverseIterator	postfix(*this);
+
+			this->_list = this->_list->_next;
+			return (postfix);
+		};
+	};
 };
 
 #endif
@@ -35,19 +35,151 @@ namespace ft
 	class list
 	{
 	private:
-		Node<T>		*_begin;
-		Node<T>		*_end;
-		Allocator	_allocator;
-		std::size_t	_size;
+		//Allocator rebound to the node type: every element node is taken from and returned to it
+		typedef typename Allocator::template conv<Node<T> >::other	node_allocator;
+
+		Node<T>			*_begin;
+		Node<T>			*_end;
+		Allocator		_allocator;
+		node_allocator	_node_allocator;
+		std::size_t		_size;
 
 		void	swap_element(T &x, T &y) {
-			T	tmp;
+			T	tmp(x);
 
-			tmp = x;
 			x = y;
 			y = tmp;
 		};
 
+		/*
+		** Allocates a detached node and copies value right into it, T is copied once.
+		** The node is built by placement new and torn down by destroy_node's explicit
+		** destructor call, so construction and destruction never go through different paths.
+		*/
+		Node<T>*	create_node(const T &value) {
+			Node<T>	*node = _node_allocator.allocate(1);
+
+			try {
+				new(node) Node<T>(value);
+			}
+			catch (...) {
+				_node_allocator.deallocate(node, 1);
+				throw ;
+			}
+			return (node);
+		};
+
+		void		destroy_node(Node<T> *node) {
+			node->~Node<T>();
+			_node_allocator.deallocate(node, 1);
+		};
+
+		//Sentinels come from the node allocator too, so an arena or a pool serves the whole list
+		Node<T>*	create_sentinel(void) {
+			Node<T>	*node = _node_allocator.allocate(1);
+
+			try {
+				new(node) Node<T>;
+			}
+			catch (...) {
+				_node_allocator.deallocate(node, 1);
+				throw ;
+			}
+			return (node);
+		};
+
+		//Allocates both sentinels and links them into the ring of an empty list
+		void		create_sentinels(void) {
+			_begin = create_sentinel();
+			try {
+				_end = create_sentinel();
+			}
+			catch (...) {
+				destroy_node(_begin);
+				throw ;
+			}
+			_begin->_next = _end;
+			_begin->_previous = _end;
+			_end->_previous = _begin;
+			_end->_next = _begin;
+		};
+
+		void		destroy_sentinels(void) {
+			destroy_node(_begin);
+			destroy_node(_end);
+		};
+
+		/*
+		** Unlinks node from the list and pushes it on the released chain
+		** (singly linked through _next). Returns the new chain head.
+		*/
+		Node<T>*	unlink_node(Node<T> *node, Node<T> *released) {
+			node->_previous->_next = node->_next;
+			node->_next->_previous = node->_previous;
+			node->_next = released;
+			_size--;
+			return (node);
+		};
+
+		//Releases a chain built by unlink_node in one pass, once the scan is over
+		void		release_nodes(Node<T> *released) {
+			Node<T>	*next;
+
+			while (released) {
+				next = released->_next;
+				destroy_node(released);
+				released = next;
+			}
+		};
+
+		/*
+		** Appends a new node holding value to the detached chain [head, tail],
+		** built off to the side of the list. On throw the chain is left intact
+		** for the caller to release.
+		*/
+		void		append_to_chain(Node<T> *&head, Node<T> *&tail, const T &value) {
+			Node<T>	*add = create_node(value);
+
+			add->_previous = tail;
+			if (tail)
+				tail->_next = add;
+			else
+				head = add;
+			tail = add;
+		};
+
+		//Links the detached chain [first, last] of count nodes before pos in one splice
+		void		link_chain(Node<T> *pos, Node<T> *first, Node<T> *last, std::size_t count) {
+			first->_previous = pos->_previous;
+			last->_next = pos;
+			pos->_previous->_next = first;
+			pos->_previous = last;
+			_size += count;
+		};
+
+		//Relinks the nodes [first, last) before pos, whatever list they belong to
+		static void	transfer(Node<T> *pos, Node<T> *first, Node<T> *last) {
+			Node<T>	*tail = last->_previous;
+
+			first->_previous->_next = last;
+			last->_previous = first->_previous;
+			first->_previous = pos->_previous;
+			tail->_next = pos;
+			pos->_previous->_next = first;
+			pos->_previous = tail;
+		};
+
+		//Nodes may only be relinked between lists whose node allocators can free each other's nodes
+		bool		shares_nodes(const list &other) const {
+			return (_node_allocator == other._node_allocator);
+		};
+
+		struct less_than {
+			bool	operator()(const T &x, const T &y) const {
+				return (x < y);
+			};
+		};
+
 	//https://en.cppreference.com/w/cpp/container/list
 	//Member types
 	public:
@@ -67,75 +199,76 @@ namespace ft
 		//https://en.cppreference.com/w/cpp/container/list/list
 		//MEMBER FUNCTIONS
 		//Default constructor. Constructs an empty container with a default-constructed allocator.
-		list(void) : _allocator(allocator_type()), _size(0) {
-			_begin = new Node<T>;
-			_end = new Node<T>;
-			_begin->_next = _end;
-			_begin->_previous = _end;
-			_end->_previous = _begin;
-			_end->_next = _begin;
+		list(void) : _allocator(allocator_type()), _node_allocator(_allocator), _size(0) {
+			create_sentinels();
 		};
 		
 		//Constructs an empty container with the given allocator alloc.
 		explicit list(const allocator_type &allocator) :
-			_allocator(allocator), _size(0) {
-				_begin = new Node<T>;
-				_end = new Node<T>;
-				_begin->_next = _end;
-				_begin->_previous = _end;
-				_end->_previous = _begin;
-				_end->_next = _begin;
+			_allocator(allocator), _node_allocator(_allocator), _size(0) {
+				create_sentinels();
 		};
 
 		//Constructs the container with count copies of elements with value value.
 		explicit list(size_type count, const_reference value = T(), const allocator_type &allocator = allocator_type()) :
-			_allocator(allocator), _size(0) {
-				_begin = new Node<T>;
-				_end = new Node<T>;
-				_begin->_next = _end;
-				_begin->_previous = _end;
-				_end->_previous = _begin;
-				_end->_next = _begin;
-				while (count--)
-					push_back(value);
+			_allocator(allocator), _node_allocator(_allocator), _size(0) {
+				create_sentinels();
+				try {
+					insert(end(), count, value);
+				}
+				catch (...) {
+					destroy_sentinels();
+					throw ;
+				}
 		};
 
 		//Constructs the container with the contents of the range [first, last).
 		template <class InputIt>
 		list(InputIt first, InputIt last, const allocator_type &allocator = allocator_type()) :
-			_allocator(allocator), _size(0) {
-				_begin = new Node<T>;
-				_end = new Node<T>;
-				_begin->_next = _end;
-				_begin->_previous = _end;
-				_end->_previous = _begin;
-				_end->_next = _begin;
-				assign<InputIt>(first, last);
+			_allocator(allocator), _node_allocator(_allocator), _size(0) {
+				create_sentinels();
+				try {
+					insert<InputIt>(end(), first, last);
+				}
+				catch (...) {
+					destroy_sentinels();
+					throw ;
+				}
 		};
 
 		//Copy constructor. Constructs the container with the copy of the contents of other
-		list(const list &copy) : _allocator(copy._allocator), _size(0) {
-			_begin = new Node<T>;
-			_end = new Node<T>;
-			_begin->_next = _end;
-			_begin->_previous = _end;
-			_end->_previous = _begin;
-			_end->_next = _begin;
-			assign(copy.begin(), copy.end());
+		list(const list &copy) : _allocator(copy._allocator), _node_allocator(_allocator), _size(0) {
+			create_sentinels();
+			try {
+				insert(end(), copy.begin(), copy.end());
+			}
+			catch (...) {
+				destroy_sentinels();
+				throw ;
+			}
 		};
 
-		//Destructor: clears allocator and deletes list elements
+		//Destructor: releases the elements, then the sentinels
 		~list(void) {
 			clear();
-			delete _begin;
-			delete _end;
+			destroy_sentinels();
 		};
 
 		//https://en.cppreference.com/w/cpp/container/list
 		//Replaces content of one container to another
 		list&					operator=(const list &other) {
-			_allocator = other._allocator;
-			assign(other.begin(), other.end());
+			if (this != &other) {
+				clear();
+				if (!(_node_allocator == node_allocator(other._allocator))) {
+					//The sentinels go back to the allocator they came from, with the old list
+					list	emptied(other._allocator);
+
+					swap(emptied);
+				}
+				_allocator = other._allocator;
+				_node_allocator = node_allocator(_allocator);
+				assign(other.begin(), other.end());
+			}
 			return (*this);
 		};
 
@@ -165,6 +298,11 @@ namespace ft
 				push_back(*it);
 		};
 
+		//https://en.cppreference.com/w/cpp/container/list/get_allocator
+		//Returns the allocator associated with the container.
+		allocator_type			get_allocator(void) const {
+			return (_allocator);
+		};
 
 		//https://en.cppreference.com/w/cpp/container/list
 		//ELEMENT ACCESS METHODS
@@ -241,47 +379,60 @@ namespace ft
 				pop_back();
 		};
 
-		//Inserts value before pos
+		//Inserts value before pos, returns iterator pointing to the inserted value
 		iterator				insert(iterator pos, const_reference value) {
-			if (pos == begin()) {
-				push_front(value);
-				return (pos);
-			}
-			else {
-				Node<T>	*add = new Node<T>(value);
-				Node<T>	*old = pos.get_list();
-
-				//Splitting old list to 2 parts and inserting new list element
-				if (old->_previous) {
-					add->_previous = old->_previous;
-					old->_previous->_next = add;
-				}
-				add->_next = old;
-				old->_previous = add;
-				_size++;
-				return (--pos);
-			}
+			Node<T>	*add = create_node(value);
+
+			link_chain(pos.get_list(), add, add, 1);
+			return (iterator(add));
 		};
 
-		//Inserts value before pos
+		/*
+		** Inserts count copies of value before pos.
+		** The nodes are chained off to the side first and linked with one splice:
+		** if a copy throws, the chain is released and the list is left unchanged.
+		*/
 		void					insert(iterator pos, size_type count, const_reference value) {
-			while (count--)
-				insert(pos, value);
+			Node<T>		*head = NULL;
+			Node<T>		*tail = NULL;
+			size_type	added;
+
+			try {
+				for (added = 0; added < count; added++)
+					append_to_chain(head, tail, value);
+			}
+			catch (...) {
+				release_nodes(head);
+				throw ;
+			}
+			if (head)
+				link_chain(pos.get_list(), head, tail, count);
 		};
 
 		void					insert(iterator pos, int count, const_reference value) {
 			if (count > 0)
-				while (count--)
-					insert(pos, value);
+				insert(pos, static_cast<size_type>(count), value);
 		};
 
-		//Inserts elements from range [first, last) before pos.
+		//Inserts elements from range [first, last) before pos, all or nothing (see above).
 		template <class InputIt>
 		void					insert(iterator pos, InputIt first, InputIt last) {
-			InputIt	it;
-			
-			for (it = first; it != last; ++it)
-				insert(pos, *it);
+			Node<T>		*head = NULL;
+			Node<T>		*tail = NULL;
+			size_type	count = 0;
+
+			try {
+				for (; first != last; ++first) {
+					append_to_chain(head, tail, *first);
+					count++;
+				}
+			}
+			catch (...) {
+				release_nodes(head);
+				throw ;
+			}
+			if (head)
+				link_chain(pos.get_list(), head, tail, count);
 		};
 
 		//Removes the element at pos (the end() iterator cannot be used as a value for pos)
@@ -291,25 +442,29 @@ namespace ft
 
 			next->_previous = prev;
 			prev->_next = next;
-			delete pos.get_list();
+			destroy_node(pos.get_list());
 			_size--;
 			return (iterator(next));
 		};
 
 		//Removes the elements in the range [first, last).
 		iterator				erase(iterator first, iterator last) {
-			iterator	it;
-			
-			for (it = first; it != last; ++it)
-				erase(it);
-			if (last == end())
-				return (iterator(_end));
+			Node<T>	*released = NULL;
+			Node<T>	*current = first.get_list();
+			Node<T>	*next;
+
+			while (current != last.get_list()) {
+				next = current->_next;
+				released = unlink_node(current, released);
+				current = next;
+			}
+			release_nodes(released);
 			return (last);
 		};
 
 		//Appends the given element value to the end of the container.
 		void					push_back(const_reference value) {
-			Node<T>	*add = new Node<T>(value);
+			Node<T>	*add = create_node(value);
 
 			add->_next = _end;
 			add->_previous = _end->_previous;
@@ -325,14 +480,14 @@ namespace ft
 
 				_end->_previous->_previous->_next = _end;
 				_end->_previous = _end->_previous->_previous;
-				delete old;
+				destroy_node(old);
 				_size--;
 			}
 		};
 
 		//Prepends the given element value to the beginning of the container.
 		void					push_front(const_reference value) {
-			Node<T>	*add = new Node<T>(value);
+			Node<T>	*add = create_node(value);
 
 			add->_next = _begin->_next;
 			add->_previous = _begin;
@@ -348,7 +503,7 @@ namespace ft
 
 				_begin->_next->_next->_previous = _begin;
 				_begin->_next = _begin->_next->_next;
-				delete old;
+				destroy_node(old);
 				_size--;
 			}
 		};
@@ -370,11 +525,23 @@ namespace ft
 		//Exchanges the contents of the container with those of other.
 		//Does not invoke any move, copy, or swap operations on individual elements.
 		void					swap(list &other) {
-			list<T>	tmp;
-
-			tmp = *this;
-			*this = other;
-			other = tmp;
+			Node<T>			*begin = _begin;
+			Node<T>			*end = _end;
+			std::size_t		size = _size;
+			Allocator		allocator = _allocator;
+			node_allocator	nodes = _node_allocator;
+
+			//Nodes go back to the allocator they came from: both allocators follow them
+			_begin = other._begin;
+			_end = other._end;
+			_size = other._size;
+			_allocator = other._allocator;
+			_node_allocator = other._node_allocator;
+			other._begin = begin;
+			other._end = end;
+			other._size = size;
+			other._allocator = allocator;
+			other._node_allocator = nodes;
 		};
 
 		//https://en.cppreference.com/w/cpp/container/list
@@ -387,44 +554,38 @@ namespace ft
 		** The function does nothing if other refers to the same object as *this.
 		*/
 		void					merge(list &other) {
-			if ((this != &other) && (!other.empty())) {
-				iterator	it = begin();
-				iterator	ito = other.begin();
-
-				while (ito != other.end()) {
-					while ((it != end()) && (*it < *ito))
-						it++;
-					if (it != end())
-						splice(it, other, ito);
-					else
-					{
-						push_back(*ito);
-						other.erase(ito);
-					}
-					ito++;
-				}
-			}
+			merge(other, less_than());
 		};
 
 		//Comp - comparison function object which returns ​true if the first argument is less than (i.e. is ordered before) the second. 
+		//Equivalent elements of *this precede those of other. Nodes are relinked, never copied,
+		//unless the allocators differ: then other is copied with ours first and cleared.
 		template <class Compare> 
 		void					merge(list &other, Compare comp) {
-			if ((this != &other) && (!other.empty())) {
-				iterator	it = begin();
-				iterator	ito = other.begin();
-
-				while (ito != other.end()) {
-					while ((it != end()) && (comp(*it, *ito)))
-						it++;
-					if (it != end())
-						splice(it, other, ito);
-					else
-					{
-						push_back(*ito);
-						other.erase(ito);
+			if ((this != &other) && (!other.empty()) && !shares_nodes(other)) {
+				list	copied(other.begin(), other.end(), _allocator);
+
+				merge(copied, comp);
+				other.clear();
+			}
+			else if ((this != &other) && (!other.empty())) {
+				Node<T>	*current = _begin->_next;
+				Node<T>	*moved = other._begin->_next;
+				Node<T>	*next;
+
+				while ((current != _end) && (moved != other._end)) {
+					if (comp(moved->_content, current->_content)) {
+						next = moved->_next;
+						transfer(current, moved, next);
+						moved = next;
 					}
-					ito++;
+					else
+						current = current->_next;
 				}
+				if (moved != other._end)
+					transfer(_end, moved, other._end);
+				_size += other._size;
+				other._size = 0;
 			}
 		};
 
@@ -432,53 +593,98 @@ namespace ft
 		** Transfers all elements from other into *this. 
 		** The elements are inserted before the element pointed to by pos. 
 		** The container other becomes empty after the operation.
-		** UB if other refers to the same object as *this.
+		** No elements are copied, the nodes are relinked in constant time.
+		** If the allocators differ, nodes of one cannot be freed by the other:
+		** the elements are copied instead and erased from other (here and below).
 		*/
 		void					splice(iterator pos, list &other) {
-			insert(pos, other.begin(), other.end());
-			other.clear();
+			if ((this != &other) && !other.empty() && !shares_nodes(other)) {
+				insert(pos, other.begin(), other.end());
+				other.clear();
+			}
+			else if ((this != &other) && !other.empty()) {
+				transfer(pos.get_list(), other._begin->_next, other._end);
+				_size += other._size;
+				other._size = 0;
+			}
 		};
 
 		//Transfers the element pointed to by it from other into *this before the *this element pointed to by pos.
 		void					splice(iterator pos, list &other, iterator it) {
-			insert(pos, *it);
-			other.erase(it);
+			Node<T>	*moved = it.get_list();
+
+			if ((pos.get_list() == moved) || (pos.get_list() == moved->_next))
+				return ;
+			if (!shares_nodes(other)) {
+				insert(pos, moved->_content);
+				other.erase(it);
+				return ;
+			}
+			transfer(pos.get_list(), moved, moved->_next);
+			other._size--;
+			_size++;
 		};
 
 		/*
 		** Transfers the elements in the range [first, last) from other into *this.
 		** The elements are inserted before the element pointed to by pos.
+		** Linear in the range length when other is another list (sizes have to be updated).
 		** UB if pos is an iterator in the range [first,last).
 		*/
-		template <class InputIt>
 		void					splice(iterator pos, list &other,
-            InputIt first, InputIt last) {
-			insert<InputIt>(pos, first, last);
-			other.erase(first, last);
+            iterator first, iterator last) {
+			if (first == last)
+				return ;
+			if (!shares_nodes(other)) {
+				insert(pos, first, last);
+				other.erase(first, last);
+				return ;
+			}
+			if (this != &other) {
+				size_type	count = 0;
+				iterator	it;
+
+				for (it = first; it != last; ++it)
+					count++;
+				other._size -= count;
+				_size += count;
+			}
+			transfer(pos.get_list(), first.get_list(), last.get_list());
 		};
 
-		//Removes all elements that are equal to value.
+		/*
+		** Removes all elements that are equal to value in a single pass.
+		** Matching nodes are unlinked as the scan goes and released together
+		** afterwards, so value may safely refer to an element of the list.
+		*/
 		void					remove(const_reference value) {
-			if (_size) {
-				iterator	it;
-
-                for (it = begin(); it != end(); ++it) {
-					if (*it == value)
-						erase(it);
-                }
+			Node<T>	*released = NULL;
+			Node<T>	*current = _begin->_next;
+			Node<T>	*next;
+
+			while (current != _end) {
+				next = current->_next;
+				if (current->_content == value)
+					released = unlink_node(current, released);
+				current = next;
 			}
+			release_nodes(released);
 		};
 
 		//Removes all elements for which predicate p returns true.
 		template <class UnaryPredicate>
 		void					remove_if(UnaryPredicate p) {
-			if (_size) {
-				iterator	it;
-
-				for (it = begin(); it != end(); ++it)
-					if (p(*it))
-						erase(it);
-			}			
+			Node<T>	*released = NULL;
+			Node<T>	*current = _begin->_next;
+			Node<T>	*next;
+
+			while (current != _end) {
+				next = current->_next;
+				if (p(current->_content))
+					released = unlink_node(current, released);
+				current = next;
+			}
+			release_nodes(released);
 		};
 
 		//Reverses the order of the elements in the container.
@@ -501,43 +707,46 @@ namespace ft
 		*/
 		void					unique(void) {
 			if (_size > 1) {
-				iterator	it = begin();
-				iterator	tmp = begin();
-
-				tmp = it++;
-				it--;
-				while ((tmp != end()) && (it != end())) {
-					if (*tmp == *it)
-						tmp = erase(tmp);
-					else {
-						tmp++;
-						it++;
-					}
+				Node<T>	*released = NULL;
+				Node<T>	*kept = _begin->_next;
+				Node<T>	*current = kept->_next;
+				Node<T>	*next;
+
+				while (current != _end) {
+					next = current->_next;
+					if (kept->_content == current->_content)
+						released = unlink_node(current, released);
+					else
+						kept = current;
+					current = next;
 				}
+				release_nodes(released);
 			}
 		};
 
 		/*
 		** Removes all consecutive duplicate elements from the container. 
 		** Only the first element in each group of equal elements is left.
-		** Uses the given binary predicate p to compare the elements.
+		** Uses the given binary predicate p(first of the group, candidate) to compare the elements.
 		*/
 		template <class BinaryPredicate>
 		void					unique(BinaryPredicate p) {
 			if (_size > 1) {
-				iterator	it = begin();
-				iterator	tmp = begin() + 1;
-
-				while (it != end()) {
-					while (tmp != end()) {
-						if (p(*tmp, *it))
-							tmp = erase(tmp);
-						else
-							tmp++;
-					}
-					it++;
+				Node<T>	*released = NULL;
+				Node<T>	*kept = _begin->_next;
+				Node<T>	*current = kept->_next;
+				Node<T>	*next;
+
+				while (current != _end) {
+					next = current->_next;
+					if (p(kept->_content, current->_content))
+						released = unlink_node(current, released);
+					else
+						kept = current;
+					current = next;
 				}
-			}		
+				release_nodes(released);
+			}
 		};
 
 		/*
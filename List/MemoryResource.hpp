@@ -0,0 +1,655 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MemoryResource.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mskinner <v.golskiy@ya.ru>                 +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/06/17 10:12:45 by mskinner          #+#    #+#             */
+/*   Updated: 2021/06/17 10:12:45 by mskinner         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Polymorphic memory resources (https://en.cppreference.com/w/cpp/memory/memory_resource):
+** the memory source of a container is an object chosen at runtime, not a template argument.
+** + one container type, ft::pmr::list<int>::type, draws from a stack buffer,
+** an arena or a pool depending on the resource it is built with,
+** + resources are chained: a monotonic buffer or a pool takes its chunks from an upstream resource;
+** - every allocation is a virtual call,
+** - resources are not copied and must outlive the containers using them.
+** Only standard headers are included, so every ft container directory may include this file.
+**
+** char								buffer[4096];
+** ft::monotonic_buffer_resource	arena(buffer, sizeof(buffer));
+** ft::pmr::vector<int>::type		numbers(&arena);
+*/
+
+#pragma once
+
+#ifndef _MEMORY_RESOURCE_HPP_
+# define _MEMORY_RESOURCE_HPP_
+
+# include <cstddef>
+# include <limits>
+# include <memory>
+# include <new>
+# include <functional>
+# include <utility>
+
+namespace ft
+{
+	//https://en.cppreference.com/w/cpp/memory/memory_resource
+	class memory_resource
+	{
+	private:
+		struct probe {
+			char		c;
+			long double	d;
+		};
+
+	public:
+		//Strictest fundamental alignment, the default of allocate() and deallocate()
+		static const std::size_t	max_align = sizeof(probe) - sizeof(long double);
+
+		virtual ~memory_resource(void) {};
+
+		//Returns bytes of storage aligned on alignment (a power of two)
+		void*	allocate(std::size_t bytes, std::size_t alignment = max_align) {
+			return (do_allocate(bytes, alignment));
+		};
+
+		//p must come from allocate() of an equal resource, with the same bytes and alignment
+		void	deallocate(void *p, std::size_t bytes, std::size_t alignment = max_align) {
+			do_deallocate(p, bytes, alignment);
+		};
+
+		//Memory allocated from one resource may be deallocated by the other
+		bool	is_equal(const memory_resource &other) const {
+			return (do_is_equal(other));
+		};
+
+	protected:
+		static std::size_t	align_up(std::size_t value, std::size_t alignment) {
+			return ((value + alignment - 1) & ~(alignment - 1));
+		};
+
+		virtual void*	do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+		virtual void	do_deallocate(void *p, std::size_t bytes, std::size_t alignment) = 0;
+		virtual bool	do_is_equal(const memory_resource &other) const = 0;
+	};
+
+	inline bool	operator==(const memory_resource &lhs, const memory_resource &rhs) {
+		return ((&lhs == &rhs) || lhs.is_equal(rhs));
+	};
+
+	inline bool	operator!=(const memory_resource &lhs, const memory_resource &rhs) {
+		return (!(lhs == rhs));
+	};
+
+	/*
+	** Global operator new and delete. Alignments above max_align are served
+	** by over-allocating and keeping the offset just before the returned block.
+	*/
+	class new_delete_memory_resource : public memory_resource
+	{
+	protected:
+		virtual void*	do_allocate(std::size_t bytes, std::size_t alignment) {
+			char	*raw;
+			char	*block;
+
+			if (alignment <= max_align)
+				return (::operator new(bytes));
+			raw = static_cast<char *>(::operator new(bytes + alignment));
+			block = reinterpret_cast<char *>(align_up(reinterpret_cast<std::size_t>(raw)
+				+ sizeof(std::size_t), alignment));
+			reinterpret_cast<std::size_t *>(block)[-1] = block - raw;
+			return (block);
+		};
+
+		virtual void	do_deallocate(void *p, std::size_t, std::size_t alignment) {
+			char	*block = static_cast<char *>(p);
+
+			if (alignment <= max_align)
+				::operator delete(p);
+			else
+				::operator delete(block - reinterpret_cast<std::size_t *>(block)[-1]);
+		};
+
+		virtual bool	do_is_equal(const memory_resource &other) const {
+			return (this == &other);
+		};
+	};
+
+	//https://en.cppreference.com/w/cpp/memory/new_delete_resource
+	inline memory_resource*	new_delete_resource(void) {
+		static new_delete_memory_resource	resource;
+
+		return (&resource);
+	};
+
+	inline memory_resource*&	default_resource(void) {
+		static memory_resource	*resource = new_delete_resource();
+
+		return (resource);
+	};
+
+	//Resource of default-constructed polymorphic allocators, new_delete_resource() at startup
+	inline memory_resource*	get_default_resource(void) {
+		return (default_resource());
+	};
+
+	//Replaces the default resource (NULL restores new_delete_resource()), returns the previous one
+	inline memory_resource*	set_default_resource(memory_resource *resource) {
+		memory_resource	*previous = default_resource();
+
+		default_resource() = resource ? resource : new_delete_resource();
+		return (previous);
+	};
+
+	/*
+	** Monotonic buffer: bump-allocates from an initial buffer, then from chunks
+	** of geometrically growing size taken from the upstream resource.
+	** deallocate() is a no-op, memory goes back upstream on release() or destruction.
+	*/
+	class monotonic_buffer_resource : public memory_resource
+	{
+	private:
+		//Header of an upstream chunk, chunk storage follows it
+		struct Chunk {
+			Chunk		*_next;
+			std::size_t	_size;
+		};
+
+		memory_resource	*_upstream;
+		Chunk			*_chunks;
+		char			*_current;
+		char			*_limit;
+		char			*_buffer;
+		std::size_t		_buffer_size;
+		std::size_t		_next_size;
+
+		monotonic_buffer_resource(const monotonic_buffer_resource &);
+		monotonic_buffer_resource&	operator=(const monotonic_buffer_resource &);
+
+		static std::size_t	header_size(void) {
+			return (align_up(sizeof(Chunk), max_align));
+		};
+
+		//Takes a chunk big enough for bytes at the worst alignment, the next one will be twice bigger
+		void	grow(std::size_t bytes, std::size_t alignment) {
+			std::size_t	size = _next_size;
+			Chunk		*chunk;
+
+			if (size < bytes + alignment)
+				size = bytes + alignment;
+			chunk = static_cast<Chunk *>(_upstream->allocate(header_size() + size, max_align));
+			chunk->_next = _chunks;
+			chunk->_size = size;
+			_chunks = chunk;
+			_current = reinterpret_cast<char *>(chunk) + header_size();
+			_limit = _current + size;
+			if (_next_size < std::numeric_limits<std::size_t>::max() / 2)
+				_next_size *= 2;
+		};
+
+	public:
+		static const std::size_t	default_size = 1024;
+
+		explicit monotonic_buffer_resource(memory_resource *upstream = get_default_resource()) :
+			_upstream(upstream), _chunks(NULL), _current(NULL), _limit(NULL),
+			_buffer(NULL), _buffer_size(0), _next_size(default_size) {};
+
+		//The first chunk taken upstream holds initial_size bytes
+		explicit monotonic_buffer_resource(std::size_t initial_size,
+			memory_resource *upstream = get_default_resource()) :
+			_upstream(upstream), _chunks(NULL), _current(NULL), _limit(NULL),
+			_buffer(NULL), _buffer_size(0), _next_size(initial_size ? initial_size : 1) {};
+
+		//Serves requests from buffer first, then from upstream chunks
+		monotonic_buffer_resource(void *buffer, std::size_t buffer_size,
+			memory_resource *upstream = get_default_resource()) :
+			_upstream(upstream), _chunks(NULL), _current(static_cast<char *>(buffer)),
+			_limit(static_cast<char *>(buffer) + buffer_size), _buffer(static_cast<char *>(buffer)),
+			_buffer_size(buffer_size), _next_size(buffer_size > default_size ? buffer_size : default_size) {};
+
+		virtual ~monotonic_buffer_resource(void) {
+			release();
+		};
+
+		//Gives every chunk back upstream, the initial buffer is reused from its start
+		void	release(void) {
+			Chunk	*next;
+
+			while (_chunks) {
+				next = _chunks->_next;
+				_upstream->deallocate(_chunks, header_size() + _chunks->_size, max_align);
+				_chunks = next;
+			}
+			_current = _buffer;
+			_limit = _buffer + _buffer_size;
+		};
+
+		memory_resource*	upstream_resource(void) const {
+			return (_upstream);
+		};
+
+	protected:
+		virtual void*	do_allocate(std::size_t bytes, std::size_t alignment) {
+			std::size_t	offset;
+
+			if (_current) {
+				offset = align_up(reinterpret_cast<std::size_t>(_current), alignment)
+					- reinterpret_cast<std::size_t>(_current);
+				if ((offset <= static_cast<std::size_t>(_limit - _current))
+					&& (bytes <= static_cast<std::size_t>(_limit - _current) - offset)) {
+					_current += offset + bytes;
+					return (_current - bytes);
+				}
+			}
+			grow(bytes, alignment);
+			return (do_allocate(bytes, alignment));
+		};
+
+		virtual void	do_deallocate(void *, std::size_t, std::size_t) {};
+
+		virtual bool	do_is_equal(const memory_resource &other) const {
+			return (this == &other);
+		};
+	};
+
+	//https://en.cppreference.com/w/cpp/memory/pool_options
+	struct pool_options {
+		//Most blocks taken upstream at once for one pool, 0 for the default
+		std::size_t	max_blocks_per_chunk;
+		//Largest request served by a pool, bigger ones go upstream, 0 for the default
+		std::size_t	largest_required_pool_block;
+
+		pool_options(void) : max_blocks_per_chunk(0), largest_required_pool_block(0) {};
+	};
+
+	/*
+	** Pools of power of two block sizes, from sizeof(void *) up to largest_required_pool_block:
+	** free blocks are chained through their own storage, chunks of blocks are taken upstream
+	** with a block count doubling up to max_blocks_per_chunk.
+	** Bigger requests go straight upstream and are given back on release() too.
+	** Not synchronized: a pool resource is to be used by one thread at a time.
+	*/
+	class unsynchronized_pool_resource : public memory_resource
+	{
+	private:
+		struct Block {
+			Block	*_next;
+		};
+
+		//Trailer of a chunk of blocks: the blocks come first to keep the chunk alignment
+		struct Chunk {
+			Chunk		*_next;
+			std::size_t	_size;
+		};
+
+		struct Pool {
+			Block		*_free;
+			Chunk		*_chunks;
+			std::size_t	_next_blocks;
+		};
+
+		//Header kept before a block allocated upstream, chaining the oversized blocks
+		struct Large {
+			Large		*_prev;
+			Large		*_next;
+			std::size_t	_size;
+			std::size_t	_alignment;
+		};
+
+		static const std::size_t	smallest_block = sizeof(void *);
+		static const std::size_t	default_blocks_per_chunk = 1024;
+		static const std::size_t	default_largest_block = 4096;
+
+		memory_resource	*_upstream;
+		pool_options	_options;
+		Pool			*_pools;
+		std::size_t		_pool_count;
+		Large			*_large;
+
+		unsynchronized_pool_resource(const unsynchronized_pool_resource &);
+		unsynchronized_pool_resource&	operator=(const unsynchronized_pool_resource &);
+
+		static std::size_t	large_header(std::size_t alignment) {
+			return (align_up(sizeof(Large), alignment > max_align ? alignment : max_align));
+		};
+
+		//Pool of the smallest block holding bytes at alignment, _pool_count if none
+		std::size_t	pool_of(std::size_t bytes, std::size_t alignment) const {
+			std::size_t	block = smallest_block;
+			std::size_t	index = 0;
+
+			if (bytes < alignment)
+				bytes = alignment;
+			while ((block < bytes) && (index < _pool_count)) {
+				block <<= 1;
+				index++;
+			}
+			return (index);
+		};
+
+		static std::size_t	block_size(std::size_t index) {
+			return (smallest_block << index);
+		};
+
+		void	create_pools(void) {
+			std::size_t	i;
+
+			_pools = static_cast<Pool *>(_upstream->allocate(_pool_count * sizeof(Pool)));
+			for (i = 0; i < _pool_count; i++) {
+				_pools[i]._free = NULL;
+				_pools[i]._chunks = NULL;
+				_pools[i]._next_blocks = 1;
+			}
+		};
+
+		static std::size_t	chunk_alignment(std::size_t index) {
+			return (block_size(index) > max_align ? block_size(index) : max_align);
+		};
+
+		//Takes a chunk of blocks upstream and chains them on the free list of the pool
+		void	grow(std::size_t index) {
+			Pool		&pool = _pools[index];
+			std::size_t	size = block_size(index);
+			std::size_t	blocks = pool._next_blocks;
+			Chunk		*chunk;
+			char		*block;
+			std::size_t	i;
+
+			block = static_cast<char *>(_upstream->allocate(blocks * size + sizeof(Chunk),
+				chunk_alignment(index))) + blocks * size;
+			chunk = reinterpret_cast<Chunk *>(block);
+			chunk->_next = pool._chunks;
+			chunk->_size = blocks * size;
+			pool._chunks = chunk;
+			for (i = 0; i < blocks; i++) {
+				block -= size;
+				reinterpret_cast<Block *>(block)->_next = pool._free;
+				pool._free = reinterpret_cast<Block *>(block);
+			}
+			if (pool._next_blocks < _options.max_blocks_per_chunk)
+				pool._next_blocks *= 2;
+			if (pool._next_blocks > _options.max_blocks_per_chunk)
+				pool._next_blocks = _options.max_blocks_per_chunk;
+		};
+
+		//Fills in the defaults and rounds the largest pooled block up to a power of two
+		void	set_options(const pool_options &options) {
+			std::size_t	largest = options.largest_required_pool_block
+				? options.largest_required_pool_block : default_largest_block;
+
+			_options.max_blocks_per_chunk = options.max_blocks_per_chunk
+				? options.max_blocks_per_chunk : default_blocks_per_chunk;
+			_pool_count = 1;
+			while (block_size(_pool_count - 1) < largest)
+				_pool_count++;
+			_options.largest_required_pool_block = block_size(_pool_count - 1);
+		};
+
+	public:
+		explicit unsynchronized_pool_resource(memory_resource *upstream = get_default_resource()) :
+			_upstream(upstream), _options(), _pools(NULL), _pool_count(0), _large(NULL) {
+			set_options(pool_options());
+		};
+
+		unsynchronized_pool_resource(const pool_options &options,
+			memory_resource *upstream = get_default_resource()) :
+			_upstream(upstream), _options(), _pools(NULL), _pool_count(0), _large(NULL) {
+			set_options(options);
+		};
+
+		virtual ~unsynchronized_pool_resource(void) {
+			release();
+			if (_pools)
+				_upstream->deallocate(_pools, _pool_count * sizeof(Pool));
+		};
+
+		//Gives every chunk and oversized block back upstream, even those still in use
+		void	release(void) {
+			Chunk		*chunk;
+			Large		*large;
+			std::size_t	i;
+
+			for (i = 0; _pools && (i < _pool_count); i++) {
+				while ((chunk = _pools[i]._chunks)) {
+					_pools[i]._chunks = chunk->_next;
+					_upstream->deallocate(reinterpret_cast<char *>(chunk) - chunk->_size,
+						chunk->_size + sizeof(Chunk), chunk_alignment(i));
+				}
+				_pools[i]._free = NULL;
+				_pools[i]._next_blocks = 1;
+			}
+			while ((large = _large)) {
+				_large = large->_next;
+				_upstream->deallocate(large, large_header(large->_alignment) + large->_size,
+					large->_alignment);
+			}
+		};
+
+		memory_resource*	upstream_resource(void) const {
+			return (_upstream);
+		};
+
+		//Options in effect, defaults filled in and largest block rounded up to a power of two
+		pool_options		options(void) const {
+			return (_options);
+		};
+
+	protected:
+		virtual void*	do_allocate(std::size_t bytes, std::size_t alignment) {
+			std::size_t	index = pool_of(bytes, alignment);
+			Large		*large;
+			Block		*block;
+
+			if (index < _pool_count) {
+				if (!_pools)
+					create_pools();
+				if (!_pools[index]._free)
+					grow(index);
+				block = _pools[index]._free;
+				_pools[index]._free = block->_next;
+				return (block);
+			}
+			if (alignment < max_align)
+				alignment = max_align;
+			large = static_cast<Large *>(_upstream->allocate(large_header(alignment) + bytes, alignment));
+			large->_prev = NULL;
+			large->_next = _large;
+			large->_size = bytes;
+			large->_alignment = alignment;
+			if (_large)
+				_large->_prev = large;
+			_large = large;
+			return (reinterpret_cast<char *>(large) + large_header(alignment));
+		};
+
+		virtual void	do_deallocate(void *p, std::size_t bytes, std::size_t alignment) {
+			std::size_t	index = pool_of(bytes, alignment);
+			Block		*block = static_cast<Block *>(p);
+			Large		*large;
+
+			if (index < _pool_count) {
+				block->_next = _pools[index]._free;
+				_pools[index]._free = block;
+				return ;
+			}
+			if (alignment < max_align)
+				alignment = max_align;
+			large = reinterpret_cast<Large *>(static_cast<char *>(p) - large_header(alignment));
+			if (large->_prev)
+				large->_prev->_next = large->_next;
+			else
+				_large = large->_next;
+			if (large->_next)
+				large->_next->_prev = large->_prev;
+			_upstream->deallocate(large, large_header(alignment) + large->_size, alignment);
+		};
+
+		virtual bool	do_is_equal(const memory_resource &other) const {
+			return (this == &other);
+		};
+	};
+
+	/*
+	** Allocator forwarding to a memory_resource: containers of one value type
+	** share one type whatever resource they draw from.
+	** Copies and rebound copies (conv<U>::other) use the same resource, so the nodes
+	** of a container come from the resource it was built with.
+	** A default-constructed allocator uses get_default_resource().
+	*/
+	template <typename T>
+	class polymorphic_allocator
+	{
+	private:
+		struct probe {
+			char	c;
+			T		t;
+		};
+
+		static const std::size_t	alignment = sizeof(probe) - sizeof(T);
+
+		memory_resource	*_resource;
+
+	//Member types
+	public:
+		typedef T											value_type;
+		typedef T											&reference;
+		typedef T											*pointer;
+		typedef const T										&const_reference;
+		typedef const T										*const_pointer;
+		typedef std::size_t									size_type;
+		typedef std::ptrdiff_t								difference_type;
+
+		template<typename U>
+		struct conv {
+			typedef polymorphic_allocator<U> other;
+		};
+
+		template<typename U>
+		struct rebind {
+			typedef polymorphic_allocator<U> other;
+		};
+
+		polymorphic_allocator() : _resource(get_default_resource()) {};
+
+		//Implicit: a container taking an allocator may be given the resource itself
+		polymorphic_allocator(memory_resource *resource) :
+			_resource(resource ? resource : get_default_resource()) {};
+
+		~polymorphic_allocator() {};
+		polymorphic_allocator(const polymorphic_allocator &copy) : _resource(copy._resource) {};
+
+		template<typename U>
+		polymorphic_allocator(const polymorphic_allocator<U> &copy) : _resource(copy.resource()) {};
+
+		polymorphic_allocator&	operator=(const polymorphic_allocator &other) {
+			_resource = other._resource;
+			return (*this);
+		};
+
+		memory_resource*	resource(void) const {
+			return (_resource);
+		};
+
+		//Getting located memory pointers
+		pointer			address(reference ref) const {
+			return (&ref);
+		};
+
+		const_pointer	address(const_reference ref) const {
+			return (&ref);
+		};
+
+		pointer			allocate(size_type cnt, const void * = 0) {
+			if (cnt > max_size())
+				throw std::bad_alloc();
+			return (static_cast<pointer>(_resource->allocate(cnt * sizeof(T), alignment)));
+		};
+
+		void			deallocate(pointer p, size_type cnt) {
+			_resource->deallocate(p, cnt * sizeof(T), alignment);
+		};
+
+		size_type		max_size() const {
+			return (std::numeric_limits<size_type>::max() / sizeof(value_type));
+		};
+
+		void			construct(pointer p, const_reference val) {
+			new(p) T(val);
+		};
+
+		void			destroy(pointer p) {
+			p->~T();
+		};
+	};
+
+	//Polymorphic allocators are equal when their resources are
+	template <class T1, class T2>
+	bool			operator==(const polymorphic_allocator<T1> &lhs, const polymorphic_allocator<T2> &rhs) {
+		return (*lhs.resource() == *rhs.resource());
+	};
+
+	template <class T1, class T2>
+	bool			operator!=(const polymorphic_allocator<T1> &lhs, const polymorphic_allocator<T2> &rhs) {
+		return (!(lhs == rhs));
+	};
+
+	//Containers, declared here so that their pmr spellings need no container header
+	template <typename T, class Allocator>
+	class vector;
+
+	template <typename T, class Allocator>
+	class list;
+
+	template <typename T, class Allocator, bool Counted>
+	class forward_list;
+
+	template <typename T, class Allocator>
+	class deque;
+
+	struct plain_tree;
+
+	template <typename Key, typename T, class Compare, class Allocator, class Augment>
+	class map;
+
+	/*
+	** C++98 has no alias templates: ft::pmr::list<int>::type is
+	** ft::list<int, ft::polymorphic_allocator<int> >.
+	** The container header itself must still be included to use the type.
+	*/
+	namespace pmr
+	{
+		template <typename T>
+		struct vector {
+			typedef ft::vector<T, polymorphic_allocator<T> >				type;
+		};
+
+		template <typename T>
+		struct list {
+			typedef ft::list<T, polymorphic_allocator<T> >				type;
+		};
+
+		template <typename T>
+		struct forward_list {
+			typedef ft::forward_list<T, polymorphic_allocator<T>, true>	type;
+		};
+
+		template <typename T>
+		struct deque {
+			typedef ft::deque<T, polymorphic_allocator<T> >				type;
+		};
+
+		template <typename Key, typename T, class Compare = std::less<Key> >
+		struct map {
+			typedef ft::map<Key, T, Compare,
+				polymorphic_allocator<std::pair<const Key, T> >, plain_tree>	type;
+		};
+	}
+}
+
+#endif
@@ -42,6 +42,113 @@ namespace ft
 			return (*this);
 		};
 	};
+
+	//Link of a singly linked list: the whole per-node overhead of ft::forward_list
+	class ForwardLink
+	{
+	public:
+		ForwardLink	*_next;
+
+		ForwardLink() : _next(NULL) {};
+		ForwardLink(const ForwardLink &copy) : _next(copy._next) {};
+		~ForwardLink() {};
+		ForwardLink& operator=(const ForwardLink &other) {
+			_next = other._next;
+			return (*this);
+		};
+	};
+
+	template < typename T >
+	class ForwardNode : public ForwardLink
+	{
+	public:
+		T		_content;
+
+		ForwardNode() : ForwardLink(), _content() {};
+		ForwardNode(const T &content) : ForwardLink(), _content(content) {};
+		ForwardNode(const ForwardNode &copy) : ForwardLink(copy), _content(copy._content) {};
+		~ForwardNode() {};
+		ForwardNode& operator=(const ForwardNode &other) {
+			if (this != &other) {
+				_next = other._next;
+				_content = other._content;
+			}
+			return (*this);
+		};
+	};
+
+	/*
+	** Links of an ft::intrusive_list embedded into the element itself (T::hook member):
+	** the element is its own node, linking it allocates and copies nothing.
+	** Copying an element never copies its list membership.
+	*/
+	class ListHook
+	{
+	public:
+		ListHook	*_previous;
+		ListHook	*_next;
+
+		ListHook() : _previous(NULL), _next(NULL) {};
+		ListHook(const ListHook &) : _previous(NULL), _next(NULL) {};
+		~ListHook() {};
+		ListHook& operator=(const ListHook &) {
+			return (*this);
+		};
+
+		bool	linked(void) const {
+			return (_next != NULL);
+		};
+
+		//Gets back the element that embeds hook as its Hook member
+		template < typename T, ListHook T::*Hook >
+		static T*	owner(const ListHook *hook) {
+			//Offset of the member measured on a fake address, nothing is dereferenced
+			T			*probe = reinterpret_cast<T *>(static_cast<std::size_t>(4096));
+			std::size_t	offset = reinterpret_cast<char *>(&(probe->*Hook))
+				- reinterpret_cast<char *>(probe);
+
+			return (reinterpret_cast<T *>(reinterpret_cast<char *>(
+				const_cast<ListHook *>(hook)) - offset));
+		};
+	};
+
+	/*
+	** Block of an unrolled list: up to K elements stored contiguously in raw storage,
+	** elements [0, _count) are constructed, the rest is uninitialized.
+	** The block is linked the same way as Node, so neighbouring elements share a cache line.
+	*/
+	template < typename T, std::size_t K >
+	class UnrolledNode
+	{
+	public:
+		UnrolledNode	*_previous;
+		UnrolledNode	*_next;
+		std::size_t		_count;
+		union {
+			unsigned char	_storage[sizeof(T) * K];
+			long double		_align;
+			void			*_align_pointer;
+		};
+
+		UnrolledNode() : _previous(NULL), _next(NULL), _count(0) {};
+
+		T*	content(void) {
+			return (reinterpret_cast<T *>(_storage));
+		};
+
+		const T*	content(void) const {
+			return (reinterpret_cast<const T *>(_storage));
+		};
+
+		bool	full(void) const {
+			return (_count == K);
+		};
+
+	private:
+		//Blocks are never copied as a whole: elements are moved one by one by the owning list
+		UnrolledNode(const UnrolledNode &);
+		UnrolledNode& operator=(const UnrolledNode &);
+	};
 };
 
 #endif
@@ -0,0 +1,429 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   PoolAllocator.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mskinner <v.golskiy@ya.ru>                 +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/06/11 11:47:52 by mskinner          #+#    #+#             */
+/*   Updated: 2021/06/11 11:47:52 by mskinner         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Pool of fixed-size slots for node-based containers:
+** slabs of BlockSize bytes are carved into slots of one element each,
+** free slots are chained through their own storage (intrusive free list).
+** + constant time allocate() and deallocate(), no heap call once slabs are warm,
+** + nodes of one container are packed in a few slabs;
+** - memory of freed slots stays in the pool until trim() or the pool destruction,
+** - only single element requests are pooled, arrays go to ::operator new.
+*/
+
+#pragma once
+
+#ifndef _POOL_ALLOCATOR_HPP_
+# define _POOL_ALLOCATOR_HPP_
+
+# include "Libraries.hpp"
+# include "Alignment.hpp"
+
+namespace ft
+{
+	class FixedPool
+	{
+	private:
+		//Header of a slab, the slots follow it
+		struct Slab {
+			Slab	*_next;
+		};
+
+		//A free slot stores the link to the next free slot
+		struct Slot {
+			Slot	*_next;
+		};
+
+		Slab		*_slabs;
+		Slot		*_free;
+		std::size_t	_slot_size;
+		std::size_t	_slots_per_slab;
+
+		//Pools are shared through their PoolSet, never copied
+		FixedPool(const FixedPool &);
+		FixedPool&	operator=(const FixedPool &);
+
+		static std::size_t	align_up(std::size_t value, std::size_t alignment) {
+			return ((value + alignment - 1) & ~(alignment - 1));
+		};
+
+		static std::size_t	header_size(void) {
+			return (align_up(sizeof(Slab), sizeof(long double)));
+		};
+
+		char*	slots(Slab *slab) const {
+			return (reinterpret_cast<char *>(slab) + header_size());
+		};
+
+		bool	owns(Slab *slab, Slot *slot) const {
+			char	*address = reinterpret_cast<char *>(slot);
+
+			return ((address >= slots(slab))
+				&& (address < slots(slab) + _slots_per_slab * _slot_size));
+		};
+
+		//Takes a slab from the heap and pushes all its slots on the free list
+		void	grow(void) {
+			Slab		*slab = static_cast<Slab *>(::operator new(header_size()
+				+ _slots_per_slab * _slot_size));
+			char		*slot = slots(slab) + _slots_per_slab * _slot_size;
+			std::size_t	i;
+
+			slab->_next = _slabs;
+			_slabs = slab;
+			for (i = 0; i < _slots_per_slab; i++) {
+				slot -= _slot_size;
+				reinterpret_cast<Slot *>(slot)->_next = _free;
+				_free = reinterpret_cast<Slot *>(slot);
+			}
+		};
+
+	public:
+		/*
+		** Size of the slots holding elements of size bytes aligned on alignment:
+		** a multiple of the alignment, so one pool serves every type of the same slot size
+		*/
+		static std::size_t	slot_size_for(std::size_t size, std::size_t alignment) {
+			if (alignment < sizeof(Slot))
+				alignment = sizeof(Slot);
+			if (size < sizeof(Slot))
+				size = sizeof(Slot);
+			return (align_up(size, alignment));
+		};
+
+		FixedPool(std::size_t slot_size, std::size_t alignment, std::size_t block_size) :
+			_slabs(NULL), _free(NULL), _slot_size(slot_size_for(slot_size, alignment)), _slots_per_slab(0) {
+			if (block_size > header_size())
+				_slots_per_slab = (block_size - header_size()) / _slot_size;
+			if (!_slots_per_slab)
+				_slots_per_slab = 1;
+		};
+
+		//Releases every slab, slots still in use become dangling
+		~FixedPool(void) {
+			Slab	*next;
+
+			while (_slabs) {
+				next = _slabs->_next;
+				::operator delete(_slabs);
+				_slabs = next;
+			}
+		};
+
+		void*	allocate(void) {
+			Slot	*slot;
+
+			if (!_free)
+				grow();
+			slot = _free;
+			_free = slot->_next;
+			return (slot);
+		};
+
+		void	deallocate(void *p) {
+			Slot	*slot = static_cast<Slot *>(p);
+
+			slot->_next = _free;
+			_free = slot;
+		};
+
+		/*
+		** Gives back to the heap the slabs whose slots are all free.
+		** Linear in free slots times slabs: meant for idle times, not for hot paths.
+		*/
+		void	trim(void) {
+			Slab		**link = &_slabs;
+			Slab		*slab;
+			Slot		**free;
+			Slot		*slot;
+			std::size_t	count;
+
+			while ((slab = *link)) {
+				count = 0;
+				for (slot = _free; slot; slot = slot->_next)
+					if (owns(slab, slot))
+						count++;
+				if (count < _slots_per_slab) {
+					link = &slab->_next;
+					continue ;
+				}
+				free = &_free;
+				while ((slot = *free)) {
+					if (owns(slab, slot))
+						*free = slot->_next;
+					else
+						free = &slot->_next;
+				}
+				*link = slab->_next;
+				::operator delete(slab);
+			}
+		};
+
+		std::size_t	slot_size(void) const {
+			return (_slot_size);
+		};
+
+		std::size_t	slabs(void) const {
+			std::size_t	count = 0;
+			Slab		*slab;
+
+			for (slab = _slabs; slab; slab = slab->_next)
+				count++;
+			return (count);
+		};
+
+		std::size_t	free_slots(void) const {
+			std::size_t	count = 0;
+			Slot		*slot;
+
+			for (slot = _free; slot; slot = slot->_next)
+				count++;
+			return (count);
+		};
+	};
+
+	/*
+	** Pools of every slot size used by a family of allocators: an allocator, its copies
+	** and its rebound copies take their slots from one PoolSet, so any of them can free
+	** the nodes of another (ft::list::splice, ft::map::join move nodes between containers).
+	** The set is destroyed, with all its pools, along with its last allocator.
+	*/
+	class PoolSet
+	{
+	private:
+		struct Entry {
+			Entry		*_next;
+			FixedPool	*_pool;
+		};
+
+		Entry		*_entries;
+		std::size_t	_block_size;
+		std::size_t	_references;
+
+		PoolSet(const PoolSet &);
+		PoolSet&	operator=(const PoolSet &);
+
+	public:
+		explicit PoolSet(std::size_t block_size) :
+			_entries(NULL), _block_size(block_size), _references(1) {};
+
+		~PoolSet(void) {
+			Entry	*next;
+
+			while (_entries) {
+				next = _entries->_next;
+				delete _entries->_pool;
+				delete _entries;
+				_entries = next;
+			}
+		};
+
+		//Pool of the slot size of elements of size bytes aligned on alignment, created on first use
+		FixedPool&	pool(std::size_t size, std::size_t alignment) {
+			std::size_t	slot_size = FixedPool::slot_size_for(size, alignment);
+			Entry		*entry;
+
+			for (entry = _entries; entry; entry = entry->_next)
+				if (entry->_pool->slot_size() == slot_size)
+					return (*entry->_pool);
+			entry = new Entry;
+			try {
+				entry->_pool = new FixedPool(size, alignment, _block_size);
+			}
+			catch (...) {
+				delete entry;
+				throw ;
+			}
+			entry->_next = _entries;
+			_entries = entry;
+			return (*entry->_pool);
+		};
+
+		void	trim(void) {
+			Entry	*entry;
+
+			for (entry = _entries; entry; entry = entry->_next)
+				entry->_pool->trim();
+		};
+
+		std::size_t	pools(void) const {
+			std::size_t	count = 0;
+			Entry		*entry;
+
+			for (entry = _entries; entry; entry = entry->_next)
+				count++;
+			return (count);
+		};
+
+		//Reference counting of the allocators sharing the set
+		void	attach(void) {
+			_references++;
+		};
+
+		bool	detach(void) {
+			return (--_references == 0);
+		};
+	};
+
+	/*
+	** Allocator of single elements from the FixedPool of sizeof(T) slots of a PoolSet.
+	** Copies and rebound copies (conv<U>::other) share the set: ft::list<T, PoolAllocator<T> >
+	** pools its Node<T> in the set of its allocator, and two lists with equal allocators
+	** can hand nodes to each other.
+	*/
+	template <typename T, std::size_t BlockSize = 4096>
+	class PoolAllocator
+	{
+	private:
+		PoolSet		*_pools;
+		FixedPool	*_pool;
+
+		static FixedPool*	pool_of(PoolSet *pools) {
+			return (&pools->pool(sizeof(T), alignment_of<T>::value));
+		};
+
+	//Member types
+	public:
+		typedef T											value_type;
+		typedef T											&reference;
+		typedef T											*pointer;
+		typedef const T										&const_reference;
+		typedef const T										*const_pointer;
+		typedef std::size_t									size_type;
+		typedef std::ptrdiff_t								difference_type;
+
+		template<typename U>
+		struct conv {
+			typedef PoolAllocator<U, BlockSize> other;
+		};
+
+		template<typename U>
+		struct rebind {
+			typedef PoolAllocator<U, BlockSize> other;
+		};
+
+		PoolAllocator() : _pools(new PoolSet(BlockSize)), _pool(NULL) {
+			try {
+				_pool = pool_of(_pools);
+			}
+			catch (...) {
+				delete _pools;
+				throw ;
+			}
+		};
+
+		~PoolAllocator() {
+			if (_pools->detach())
+				delete _pools;
+		};
+
+		PoolAllocator(const PoolAllocator &copy) : _pools(copy._pools), _pool(copy._pool) {
+			_pools->attach();
+		};
+
+		template<typename U>
+		PoolAllocator(const PoolAllocator<U, BlockSize> &copy) :
+			_pools(&copy.pools()), _pool(pool_of(&copy.pools())) {
+			_pools->attach();
+		};
+
+		PoolAllocator&	operator=(const PoolAllocator &other) {
+			other._pools->attach();
+			if (_pools->detach())
+				delete _pools;
+			_pools = other._pools;
+			_pool = other._pool;
+			return (*this);
+		};
+
+		PoolSet&		pools(void) const {
+			return (*_pools);
+		};
+
+		//Exchanges the sets: both stay attached once, no reference count changes
+		void			swap(PoolAllocator &other) {
+			PoolSet		*pools = _pools;
+			FixedPool	*pool = _pool;
+
+			_pools = other._pools;
+			_pool = other._pool;
+			other._pools = pools;
+			other._pool = pool;
+		};
+
+		FixedPool&		pool(void) const {
+			return (*_pool);
+		};
+
+		//Gives back to the heap the slabs with no element in use, in every pool of the set
+		void			trim(void) {
+			_pools->trim();
+		};
+
+		//Getting located memory pointers
+		pointer			address(reference ref) const {
+			return (&ref);
+		};
+
+		const_pointer	address(const_reference ref) const {
+			return (&ref);
+		};
+
+		//A slot from the pool for one element, ::operator new for arrays
+		pointer			allocate(size_type cnt, const void * = 0) {
+			if (cnt == 1)
+				return (static_cast<pointer>(_pool->allocate()));
+			if (cnt > max_size())
+				throw std::bad_alloc();
+			return (static_cast<pointer>(::operator new(cnt * sizeof(T))));
+		};
+
+		//cnt must be the value passed to allocate(), as for ft::Allocator
+		void			deallocate(pointer p, size_type cnt) {
+			if (cnt == 1)
+				_pool->deallocate(p);
+			else
+				::operator delete(p);
+		};
+
+		size_type		max_size() const {
+			return (std::numeric_limits<size_type>::max() / sizeof(value_type));
+		};
+
+		void			construct(pointer p, const_reference val) {
+			new(p) T(val);
+		};
+
+		void			destroy(pointer p) {
+			p->~T();
+		};
+	};
+
+	//Pool allocators are equal when memory from one can be given back to the other: they share a set
+	template <class T1, class T2, std::size_t BlockSize>
+	bool			operator==(const PoolAllocator<T1, BlockSize> &lhs, const PoolAllocator<T2, BlockSize> &rhs) {
+		return (&lhs.pools() == &rhs.pools());
+	};
+
+	template <class T1, class T2, std::size_t BlockSize>
+	bool			operator!=(const PoolAllocator<T1, BlockSize> &lhs, const PoolAllocator<T2, BlockSize> &rhs) {
+		return (&lhs.pools() != &rhs.pools());
+	};
+
+	//Picked by the containers' swap_element(): no temporary allocator, no reference count churn
+	template <class T, std::size_t BlockSize>
+	void			swap_element(PoolAllocator<T, BlockSize> &x, PoolAllocator<T, BlockSize> &y) {
+		x.swap(y);
+	};
+}
+
+#endif
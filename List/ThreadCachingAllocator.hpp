@@ -0,0 +1,314 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ThreadCachingAllocator.hpp                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mskinner <v.golskiy@ya.ru>                 +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/06/14 10:02:36 by mskinner          #+#    #+#             */
+/*   Updated: 2021/06/14 10:02:36 by mskinner         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Thread caching heap: small blocks are rounded up to size classes of
+** granularity bytes, every thread keeps its own free list per class and
+** only locks the shared central list of a class to move a whole batch.
+** + no lock on allocate() and deallocate() while the thread cache has blocks,
+** + a block freed by another thread joins that thread's cache: cross-thread frees are safe,
+** + a thread cache holding too many blocks gives a batch back to the central list,
+** + the cache of an exiting thread is given back to the central lists;
+** - blocks are carved from slabs that stay in the heap for the process lifetime,
+** - requests above max_size bytes go straight to ::operator new.
+** Needs POSIX threads: build with -pthread.
+*/
+
+#pragma once
+
+#ifndef _THREAD_CACHING_ALLOCATOR_HPP_
+# define _THREAD_CACHING_ALLOCATOR_HPP_
+
+# include "Libraries.hpp"
+# include <pthread.h>
+
+namespace ft
+{
+	//Statics of a class template can be defined in a header: Dummy only serves that purpose
+	template <int Dummy = 0>
+	class ThreadHeapBase
+	{
+	public:
+		static const std::size_t	granularity = 16;
+		static const std::size_t	classes = 32;
+		static const std::size_t	max_size = granularity * classes;
+		//Blocks moved at once between a thread cache and a central list
+		static const std::size_t	batch = 32;
+		//Blocks a thread cache keeps per class before giving a batch back
+		static const std::size_t	cache_limit = 4 * batch;
+
+	private:
+		struct Block {
+			Block	*_next;
+		};
+
+		struct Cache {
+			Block		*_free[classes];
+			std::size_t	_count[classes];
+		};
+
+		struct Central {
+			pthread_mutex_t	_mutex;
+			Block			*_free;
+			std::size_t		_count;
+		};
+
+		static pthread_once_t	_once;
+		static pthread_key_t	_key;
+		static Central			_central[classes];
+
+		ThreadHeapBase(void);
+
+		static std::size_t	class_of(std::size_t bytes) {
+			return ((bytes + granularity - 1) / granularity - 1);
+		};
+
+		static std::size_t	block_size(std::size_t index) {
+			return ((index + 1) * granularity);
+		};
+
+		static void			initialize(void) {
+			std::size_t	i;
+
+			for (i = 0; i < classes; i++) {
+				pthread_mutex_init(&_central[i]._mutex, NULL);
+				_central[i]._free = NULL;
+				_central[i]._count = 0;
+			}
+			pthread_key_create(&_key, release_cache);
+		};
+
+		//Cache of the calling thread, created on its first allocation
+		static Cache*		cache(void) {
+			Cache		*local;
+			std::size_t	i;
+
+			pthread_once(&_once, initialize);
+			local = static_cast<Cache *>(pthread_getspecific(_key));
+			if (!local) {
+				local = static_cast<Cache *>(::operator new(sizeof(Cache)));
+				for (i = 0; i < classes; i++) {
+					local->_free[i] = NULL;
+					local->_count[i] = 0;
+				}
+				pthread_setspecific(_key, local);
+			}
+			return (local);
+		};
+
+		//Moves up to batch blocks of the central list to the cache, carving a slab if it is empty
+		static void			fetch(Cache *local, std::size_t index) {
+			Central		&central = _central[index];
+			Block		*block;
+			char		*slab;
+			std::size_t	i;
+
+			pthread_mutex_lock(&central._mutex);
+			for (i = 0; (i < batch) && central._free; i++) {
+				block = central._free;
+				central._free = block->_next;
+				block->_next = local->_free[index];
+				local->_free[index] = block;
+			}
+			central._count -= i;
+			pthread_mutex_unlock(&central._mutex);
+			if (i)
+				local->_count[index] += i;
+			else {
+				slab = static_cast<char *>(::operator new(batch * block_size(index)));
+				for (i = 0; i < batch; i++) {
+					block = reinterpret_cast<Block *>(slab + i * block_size(index));
+					block->_next = local->_free[index];
+					local->_free[index] = block;
+				}
+				local->_count[index] += batch;
+			}
+		};
+
+		//Gives all but keep blocks of the cache back to the central list
+		static void			flush(Cache *local, std::size_t index, std::size_t keep) {
+			Central		&central = _central[index];
+			Block		*first;
+			Block		*last;
+			std::size_t	count = 0;
+
+			if (local->_count[index] <= keep)
+				return ;
+			first = local->_free[index];
+			last = first;
+			while (++count < local->_count[index] - keep)
+				last = last->_next;
+			local->_free[index] = last->_next;
+			local->_count[index] = keep;
+			pthread_mutex_lock(&central._mutex);
+			last->_next = central._free;
+			central._free = first;
+			central._count += count;
+			pthread_mutex_unlock(&central._mutex);
+		};
+
+		//Thread exit: every cached block goes back to the central lists
+		static void			release_cache(void *data) {
+			Cache		*local = static_cast<Cache *>(data);
+			std::size_t	i;
+
+			for (i = 0; i < classes; i++)
+				flush(local, i, 0);
+			::operator delete(local);
+		};
+
+	public:
+		static void*		allocate(std::size_t bytes) {
+			Cache		*local;
+			Block		*block;
+			std::size_t	index;
+
+			if (!bytes || (bytes > max_size))
+				return (::operator new(bytes));
+			local = cache();
+			index = class_of(bytes);
+			if (!local->_free[index])
+				fetch(local, index);
+			block = local->_free[index];
+			local->_free[index] = block->_next;
+			local->_count[index]--;
+			return (block);
+		};
+
+		//bytes must be the size given to allocate(), any thread may give the block back
+		static void			deallocate(void *p, std::size_t bytes) {
+			Cache		*local;
+			Block		*block = static_cast<Block *>(p);
+			std::size_t	index;
+
+			if (!bytes || (bytes > max_size)) {
+				::operator delete(p);
+				return ;
+			}
+			local = cache();
+			index = class_of(bytes);
+			block->_next = local->_free[index];
+			local->_free[index] = block;
+			if (++local->_count[index] > cache_limit)
+				flush(local, index, cache_limit - batch);
+		};
+
+		//Blocks of bytes size class cached by the calling thread
+		static std::size_t	cached(std::size_t bytes) {
+			return (cache()->_count[class_of(bytes)]);
+		};
+
+		//Blocks of bytes size class waiting in the central list
+		static std::size_t	central(std::size_t bytes) {
+			Central		&list = _central[class_of(bytes)];
+			std::size_t	count;
+
+			pthread_once(&_once, initialize);
+			pthread_mutex_lock(&list._mutex);
+			count = list._count;
+			pthread_mutex_unlock(&list._mutex);
+			return (count);
+		};
+	};
+
+	template <int Dummy>
+	pthread_once_t	ThreadHeapBase<Dummy>::_once = PTHREAD_ONCE_INIT;
+
+	template <int Dummy>
+	pthread_key_t	ThreadHeapBase<Dummy>::_key;
+
+	template <int Dummy>
+	typename ThreadHeapBase<Dummy>::Central	ThreadHeapBase<Dummy>::_central[ThreadHeapBase<Dummy>::classes];
+
+	typedef ThreadHeapBase<>	ThreadHeap;
+
+	/*
+	** Stateless allocator on top of the ft::ThreadHeap: every instance, of every type,
+	** draws from the same heap, so containers may be created, modified and destroyed
+	** by different threads.
+	*/
+	template <typename T>
+	class ThreadCachingAllocator
+	{
+	//Member types
+	public:
+		typedef T											value_type;
+		typedef T											&reference;
+		typedef T											*pointer;
+		typedef const T										&const_reference;
+		typedef const T										*const_pointer;
+		typedef std::size_t									size_type;
+		typedef std::ptrdiff_t								difference_type;
+
+		template<typename U>
+		struct conv {
+			typedef ThreadCachingAllocator<U> other;
+		};
+
+		template<typename U>
+		struct rebind {
+			typedef ThreadCachingAllocator<U> other;
+		};
+
+		ThreadCachingAllocator() {};
+		~ThreadCachingAllocator() {};
+		ThreadCachingAllocator(const ThreadCachingAllocator &) {};
+
+		template<typename U>
+		ThreadCachingAllocator(const ThreadCachingAllocator<U> &) {};
+
+		//Getting located memory pointers
+		pointer			address(reference ref) const {
+			return (&ref);
+		};
+
+		const_pointer	address(const_reference ref) const {
+			return (&ref);
+		};
+
+		pointer			allocate(size_type cnt, const void * = 0) {
+			if (cnt > max_size())
+				throw std::bad_alloc();
+			return (static_cast<pointer>(ThreadHeap::allocate(cnt * sizeof(T))));
+		};
+
+		void			deallocate(pointer p, size_type cnt) {
+			ThreadHeap::deallocate(p, cnt * sizeof(T));
+		};
+
+		size_type		max_size() const {
+			return (std::numeric_limits<size_type>::max() / sizeof(value_type));
+		};
+
+		void			construct(pointer p, const_reference val) {
+			new(p) T(val);
+		};
+
+		void			destroy(pointer p) {
+			p->~T();
+		};
+	};
+
+	//All thread caching allocators share the heap: always true
+	template <class T1, class T2>
+	bool			operator==(const ThreadCachingAllocator<T1> &, const ThreadCachingAllocator<T2> &) {
+		return (true);
+	};
+
+	//Always false
+	template <class T1, class T2>
+	bool			operator!=(const ThreadCachingAllocator<T1> &, const ThreadCachingAllocator<T2> &) {
+		return (false);
+	};
+}
+
+#endif
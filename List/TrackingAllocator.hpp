@@ -0,0 +1,306 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TrackingAllocator.hpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mskinner <v.golskiy@ya.ru>                 +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/06/15 16:40:12 by mskinner          #+#    #+#             */
+/*   Updated: 2021/06/15 16:40:12 by mskinner         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Tracking allocator: forwards every request to an Inner allocator and counts
+** calls, live and peak bytes and a histogram of request sizes.
+** Copies and rebound copies (conv<U>::other) share their statistics, so the
+** nodes of a container are attributed to the allocator it was built with.
+** Statistics can be kept under a tag in the global ft::AllocationRegistry
+** to be looked up and reported from anywhere in the program.
+** Counters are not synchronized: a tag is to be shared by one thread only.
+**
+** ft::list<int, ft::TrackingAllocator<int> >	sessions((ft::TrackingAllocator<int>("sessions")));
+** ft::AllocationRegistry::report(std::cout);
+*/
+
+#pragma once
+
+#ifndef _TRACKING_ALLOCATOR_HPP_
+# define _TRACKING_ALLOCATOR_HPP_
+
+# include "Allocator.hpp"
+# include <cstring>
+
+namespace ft
+{
+	class AllocationStats
+	{
+	public:
+		//Bucket i counts the requests of up to 2^(i + 3) bytes, the last one all bigger requests
+		static const std::size_t	buckets = 16;
+
+		std::size_t	allocations;
+		std::size_t	deallocations;
+		std::size_t	bytes_live;
+		std::size_t	bytes_peak;
+		std::size_t	bytes_total;
+		std::size_t	histogram[buckets];
+
+		AllocationStats(void) : allocations(0), deallocations(0),
+			bytes_live(0), bytes_peak(0), bytes_total(0), _references(1) {
+			std::size_t	i;
+
+			for (i = 0; i < buckets; i++)
+				histogram[i] = 0;
+		};
+
+		static std::size_t	bucket_of(std::size_t bytes) {
+			std::size_t	bucket = 0;
+			std::size_t	limit = 8;
+
+			while ((bytes > limit) && (bucket < buckets - 1)) {
+				limit <<= 1;
+				bucket++;
+			}
+			return (bucket);
+		};
+
+		void	record_allocate(std::size_t bytes) {
+			allocations++;
+			bytes_total += bytes;
+			bytes_live += bytes;
+			if (bytes_live > bytes_peak)
+				bytes_peak = bytes_live;
+			histogram[bucket_of(bytes)]++;
+		};
+
+		void	record_deallocate(std::size_t bytes) {
+			deallocations++;
+			bytes_live -= bytes;
+		};
+
+		void	print(std::ostream &out) const {
+			std::size_t	i;
+
+			out << "allocations: " << allocations << ", deallocations: " << deallocations;
+			out << ", live bytes: " << bytes_live << ", peak bytes: " << bytes_peak;
+			out << ", histogram:";
+			for (i = 0; i < buckets; i++)
+				if (histogram[i]) {
+					if (i == buckets - 1)
+						out << " >" << (static_cast<std::size_t>(8) << (i - 1));
+					else
+						out << " <=" << (static_cast<std::size_t>(8) << i);
+					out << " x" << histogram[i];
+				}
+		};
+
+		//Reference counting of the allocators sharing the statistics
+		void	attach(void) {
+			_references++;
+		};
+
+		bool	detach(void) {
+			return (--_references == 0);
+		};
+
+	private:
+		std::size_t	_references;
+
+		AllocationStats(const AllocationStats &);
+		AllocationStats&	operator=(const AllocationStats &);
+	};
+
+	//Statics of a class template can be defined in a header: Dummy only serves that purpose
+	template <int Dummy = 0>
+	class AllocationRegistryBase
+	{
+	private:
+		struct Entry {
+			Entry			*_next;
+			const char		*_tag;
+			AllocationStats	*_stats;
+		};
+
+		static Entry	*_entries;
+
+		AllocationRegistryBase(void);
+
+	public:
+		/*
+		** Statistics kept under tag, created on first use. The registry keeps them, and its own
+		** copy of tag, for the process lifetime: tag may be a temporary buffer.
+		*/
+		static AllocationStats&	stats(const char *tag) {
+			AllocationStats	*found = find(tag);
+			Entry			*entry;
+			char			*copy;
+
+			if (found)
+				return (*found);
+			entry = new Entry;
+			try {
+				copy = new char[std::strlen(tag) + 1];
+			}
+			catch (...) {
+				delete entry;
+				throw ;
+			}
+			try {
+				entry->_stats = new AllocationStats();
+			}
+			catch (...) {
+				delete [] copy;
+				delete entry;
+				throw ;
+			}
+			entry->_tag = std::strcpy(copy, tag);
+			entry->_next = _entries;
+			_entries = entry;
+			return (*entry->_stats);
+		};
+
+		static AllocationStats*	find(const char *tag) {
+			Entry	*entry;
+
+			for (entry = _entries; entry; entry = entry->_next)
+				if (!std::strcmp(entry->_tag, tag))
+					return (entry->_stats);
+			return (NULL);
+		};
+
+		//Prints one line of statistics per tag
+		static void				report(std::ostream &out) {
+			Entry	*entry;
+
+			for (entry = _entries; entry; entry = entry->_next) {
+				out << entry->_tag << ": ";
+				entry->_stats->print(out);
+				out << std::endl;
+			}
+		};
+	};
+
+	template <int Dummy>
+	typename AllocationRegistryBase<Dummy>::Entry	*AllocationRegistryBase<Dummy>::_entries = NULL;
+
+	typedef AllocationRegistryBase<>	AllocationRegistry;
+
+	template <typename T, class Inner = ft::Allocator<T> >
+	class TrackingAllocator
+	{
+	private:
+		Inner			_inner;
+		AllocationStats	*_stats;
+
+	//Member types
+	public:
+		typedef T											value_type;
+		typedef T											&reference;
+		typedef T											*pointer;
+		typedef const T										&const_reference;
+		typedef const T										*const_pointer;
+		typedef std::size_t									size_type;
+		typedef std::ptrdiff_t								difference_type;
+
+		template<typename U>
+		struct conv {
+			typedef TrackingAllocator<U, typename Inner::template conv<U>::other> other;
+		};
+
+		template<typename U>
+		struct rebind {
+			typedef TrackingAllocator<U, typename Inner::template conv<U>::other> other;
+		};
+
+		//Allocator with statistics of its own, shared by its copies only
+		TrackingAllocator() : _inner(), _stats(new AllocationStats()) {};
+
+		explicit TrackingAllocator(const Inner &inner) : _inner(inner), _stats(new AllocationStats()) {};
+
+		//Allocator recording into the registry statistics of tag
+		explicit TrackingAllocator(const char *tag, const Inner &inner = Inner()) :
+			_inner(inner), _stats(&AllocationRegistry::stats(tag)) {
+			_stats->attach();
+		};
+
+		~TrackingAllocator() {
+			if (_stats->detach())
+				delete _stats;
+		};
+
+		TrackingAllocator(const TrackingAllocator &copy) : _inner(copy._inner), _stats(copy._stats) {
+			_stats->attach();
+		};
+
+		template<typename U, class OtherInner>
+		TrackingAllocator(const TrackingAllocator<U, OtherInner> &copy) :
+			_inner(copy.inner()), _stats(&copy.stats()) {
+			_stats->attach();
+		};
+
+		TrackingAllocator&	operator=(const TrackingAllocator &other) {
+			other._stats->attach();
+			if (_stats->detach())
+				delete _stats;
+			_stats = other._stats;
+			_inner = other._inner;
+			return (*this);
+		};
+
+		AllocationStats&	stats(void) const {
+			return (*_stats);
+		};
+
+		const Inner&		inner(void) const {
+			return (_inner);
+		};
+
+		//Getting located memory pointers
+		pointer			address(reference ref) const {
+			return (&ref);
+		};
+
+		const_pointer	address(const_reference ref) const {
+			return (&ref);
+		};
+
+		//Records the request once Inner has served it
+		pointer			allocate(size_type cnt, const void *hint = 0) {
+			pointer	p = _inner.allocate(cnt, hint);
+
+			_stats->record_allocate(cnt * sizeof(T));
+			return (p);
+		};
+
+		void			deallocate(pointer p, size_type cnt) {
+			_inner.deallocate(p, cnt);
+			_stats->record_deallocate(cnt * sizeof(T));
+		};
+
+		size_type		max_size() const {
+			return (_inner.max_size());
+		};
+
+		void			construct(pointer p, const_reference val) {
+			_inner.construct(p, val);
+		};
+
+		void			destroy(pointer p) {
+			_inner.destroy(p);
+		};
+	};
+
+	//Tracking allocators are equal when they share statistics and their inner allocators are equal
+	template <class T1, class I1, class T2, class I2>
+	bool			operator==(const TrackingAllocator<T1, I1> &lhs, const TrackingAllocator<T2, I2> &rhs) {
+		return ((&lhs.stats() == &rhs.stats()) && (lhs.inner() == rhs.inner()));
+	};
+
+	template <class T1, class I1, class T2, class I2>
+	bool			operator!=(const TrackingAllocator<T1, I1> &lhs, const TrackingAllocator<T2, I2> &rhs) {
+		return (!(lhs == rhs));
+	};
+}
+
+#endif
@@ -0,0 +1,241 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Uninitialized.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mskinner <v.golskiy@ya.ru>                 +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/06/21 09:48:17 by mskinner          #+#    #+#             */
+/*   Updated: 2021/06/21 09:48:17 by mskinner         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Algorithms on uninitialized storage going through an allocator
+** (https://en.cppreference.com/w/cpp/memory#Uninitialized_memory_algorithms):
+** + a range is either fully constructed or, when a copy throws, the copies
+** already made are destroyed before the exception goes on,
+** + types marked by ft::is_trivial are copied with memcpy() and memmove(),
+** and are neither constructed nor destroyed one by one;
+** - the fast path skips Alloc::construct() and Alloc::destroy() for trivial types:
+** allocators must not count on them being called for such types.
+** Only standard headers are included, so every ft container directory may include this file.
+*/
+
+#pragma once
+
+#ifndef _UNINITIALIZED_HPP_
+# define _UNINITIALIZED_HPP_
+
+# include <cstddef>
+# include <cstring>
+
+namespace ft
+{
+	/*
+	** C++98 cannot tell trivial types apart: arithmetic types and pointers are marked here,
+	** a trivial type of the program may be marked by specializing ft::is_trivial.
+	*/
+	template <typename T>
+	struct is_trivial {
+		static const bool	value = false;
+	};
+
+	template <typename T>
+	struct is_trivial<T *> {
+		static const bool	value = true;
+	};
+
+	template <> struct is_trivial<bool> { static const bool value = true; };
+	template <> struct is_trivial<char> { static const bool value = true; };
+	template <> struct is_trivial<signed char> { static const bool value = true; };
+	template <> struct is_trivial<unsigned char> { static const bool value = true; };
+	template <> struct is_trivial<wchar_t> { static const bool value = true; };
+	template <> struct is_trivial<short> { static const bool value = true; };
+	template <> struct is_trivial<unsigned short> { static const bool value = true; };
+	template <> struct is_trivial<int> { static const bool value = true; };
+	template <> struct is_trivial<unsigned int> { static const bool value = true; };
+	template <> struct is_trivial<long> { static const bool value = true; };
+	template <> struct is_trivial<unsigned long> { static const bool value = true; };
+	template <> struct is_trivial<float> { static const bool value = true; };
+	template <> struct is_trivial<double> { static const bool value = true; };
+	template <> struct is_trivial<long double> { static const bool value = true; };
+
+	//Overload selector on a compile time condition
+	template <bool Condition>
+	struct bool_tag {};
+
+	//Destroys the objects of [first, last) through the allocator, nothing for trivial types
+	template <typename T, class Alloc>
+	void	destroy_range_a(T *first, T *last, Alloc &, bool_tag<true>) {
+		(void)first;
+		(void)last;
+	};
+
+	template <typename T, class Alloc>
+	void	destroy_range_a(T *first, T *last, Alloc &allocator, bool_tag<false>) {
+		for (; first != last; ++first)
+			allocator.destroy(first);
+	};
+
+	template <typename T, class Alloc>
+	void	destroy_range_a(T *first, T *last, Alloc &allocator) {
+		destroy_range_a(first, last, allocator, bool_tag<is_trivial<T>::value>());
+	};
+
+	/*
+	** Scope guard of a range being constructed from first on:
+	** unless release() is called, its destructor destroys what was constructed.
+	*/
+	template <typename T, class Alloc>
+	class ConstructionGuard
+	{
+	private:
+		Alloc	&_allocator;
+		T		*_first;
+		T		*_current;
+		bool	_released;
+
+		ConstructionGuard(const ConstructionGuard &);
+		ConstructionGuard&	operator=(const ConstructionGuard &);
+
+	public:
+		ConstructionGuard(Alloc &allocator, T *first) :
+			_allocator(allocator), _first(first), _current(first), _released(false) {};
+
+		~ConstructionGuard(void) {
+			if (!_released)
+				destroy_range_a(_first, _current, _allocator);
+		};
+
+		//Copy-constructs value at the end of the range
+		void	construct(const T &value) {
+			_allocator.construct(_current, value);
+			++_current;
+		};
+
+		//Keeps the range constructed, returns its end
+		T*		release(void) {
+			_released = true;
+			return (_current);
+		};
+	};
+
+	/*
+	** Copy-constructs [first, last) into raw storage at dest, returns the end of the copies.
+	** If a copy throws, the copies already made are destroyed.
+	*/
+	template <class InputIt, typename T, class Alloc>
+	T*		uninitialized_copy_a(InputIt first, InputIt last, T *dest, Alloc &allocator) {
+		ConstructionGuard<T, Alloc>	guard(allocator, dest);
+
+		for (; first != last; ++first)
+			guard.construct(*first);
+		return (guard.release());
+	};
+
+	template <typename T, class Alloc>
+	T*		uninitialized_copy_a(const T *first, const T *last, T *dest, Alloc &allocator, bool_tag<true>) {
+		(void)allocator;
+		if (first != last)
+			std::memcpy(dest, first, (last - first) * sizeof(T));
+		return (dest + (last - first));
+	};
+
+	template <typename T, class Alloc>
+	T*		uninitialized_copy_a(const T *first, const T *last, T *dest, Alloc &allocator, bool_tag<false>) {
+		ConstructionGuard<T, Alloc>	guard(allocator, dest);
+
+		for (; first != last; ++first)
+			guard.construct(*first);
+		return (guard.release());
+	};
+
+	//Contiguous sources: a single memcpy() for trivial types
+	template <typename T, class Alloc>
+	T*		uninitialized_copy_a(const T *first, const T *last, T *dest, Alloc &allocator) {
+		return (uninitialized_copy_a(first, last, dest, allocator, bool_tag<is_trivial<T>::value>()));
+	};
+
+	template <typename T, class Alloc>
+	T*		uninitialized_copy_a(T *first, T *last, T *dest, Alloc &allocator) {
+		return (uninitialized_copy_a(static_cast<const T *>(first), static_cast<const T *>(last),
+			dest, allocator, bool_tag<is_trivial<T>::value>()));
+	};
+
+	template <typename T, class Alloc>
+	T*		uninitialized_fill_n_a(T *dest, std::size_t count, const T &value, Alloc &, bool_tag<true>) {
+		T	copy(value);
+
+		for (; count; --count, ++dest)
+			*dest = copy;
+		return (dest);
+	};
+
+	template <typename T, class Alloc>
+	T*		uninitialized_fill_n_a(T *dest, std::size_t count, const T &value, Alloc &allocator, bool_tag<false>) {
+		ConstructionGuard<T, Alloc>	guard(allocator, dest);
+
+		for (; count; --count)
+			guard.construct(value);
+		return (guard.release());
+	};
+
+	/*
+	** Copy-constructs count copies of value into raw storage at dest, returns the end of the copies.
+	** If a copy throws, the copies already made are destroyed.
+	*/
+	template <typename T, class Alloc>
+	T*		uninitialized_fill_n_a(T *dest, std::size_t count, const T &value, Alloc &allocator) {
+		return (uninitialized_fill_n_a(dest, count, value, allocator, bool_tag<is_trivial<T>::value>()));
+	};
+
+	template <typename T>
+	T*		assign_range(const T *first, const T *last, T *dest, bool_tag<true>) {
+		if (first != last)
+			std::memmove(dest, first, (last - first) * sizeof(T));
+		return (dest + (last - first));
+	};
+
+	template <typename T>
+	T*		assign_range(const T *first, const T *last, T *dest, bool_tag<false>) {
+		for (; first != last; ++first, ++dest)
+			*dest = *first;
+		return (dest);
+	};
+
+	/*
+	** Assigns [first, last) to the constructed objects from dest on, front to back:
+	** dest may be below first in the same range. Returns the end of the assigned objects.
+	** If an assignment throws, every object is still constructed.
+	*/
+	template <typename T>
+	T*		assign_range(const T *first, const T *last, T *dest) {
+		return (assign_range(first, last, dest, bool_tag<is_trivial<T>::value>()));
+	};
+
+	template <typename T>
+	T*		assign_range_backward(const T *first, const T *last, T *dest_last, bool_tag<true>) {
+		if (first != last)
+			std::memmove(dest_last - (last - first), first, (last - first) * sizeof(T));
+		return (dest_last - (last - first));
+	};
+
+	template <typename T>
+	T*		assign_range_backward(const T *first, const T *last, T *dest_last, bool_tag<false>) {
+		while (last != first)
+			*--dest_last = *--last;
+		return (dest_last);
+	};
+
+	/*
+	** Assigns [first, last) to the constructed objects ending at dest_last, back to front:
+	** dest_last may be above last in the same range. Returns the first assigned object.
+	*/
+	template <typename T>
+	T*		assign_range_backward(const T *first, const T *last, T *dest_last) {
+		return (assign_range_backward(first, last, dest_last, bool_tag<is_trivial<T>::value>()));
+	};
+}
+
+#endif
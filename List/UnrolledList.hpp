@@ -0,0 +1,522 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UnrolledList.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mskinner <v.golskiy@ya.ru>                 +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/06/07 10:12:41 by mskinner          #+#    #+#             */
+/*   Updated: 2021/06/07 10:12:41 by mskinner         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Unrolled lists are sequence containers built as a doubly-linked list of blocks,
+** every block stores up to K elements contiguously:
+** + iteration walks arrays instead of chasing one pointer per element (cache friendly),
+** + link overhead is paid once per block, not once per element,
+** + amortized constant time insert and erase at an iterator (shifting inside one block only),
+** - insert and erase invalidate iterators to the elements of the touched blocks,
+** - no splice: elements live inside blocks and can not be relinked one by one.
+** Full blocks are split in halves on insert, blocks less than half full
+** are merged with their successor on erase.
+*/
+
+#pragma once
+
+#ifndef _UNROLLED_LIST_HPP_
+# define _UNROLLED_LIST_HPP_
+
+# include "Node.hpp"
+# include "Iterator.hpp"
+# include "Allocator.hpp"
+# include "Uninitialized.hpp"
+
+namespace ft
+{
+	template <typename T, std::size_t K = 16, class Allocator = ft::Allocator<T> >
+	class unrolled_list
+	{
+	private:
+		typedef UnrolledNode<T, K>									block;
+		typedef typename Allocator::template conv<block>::other	block_allocator;
+
+		//Sentinel block (never holds elements): _end->_next is the first block, _end->_previous the last
+		block			*_end;
+		Allocator		_allocator;
+		block_allocator	_block_allocator;
+		std::size_t		_size;
+
+		//Predicate used by remove(): keeps its own copy, value may be an element being removed
+		struct equal_to_value {
+			T	value;
+
+			equal_to_value(const T &val) : value(val) {};
+			bool	operator()(const T &other) const {
+				return (other == value);
+			};
+		};
+
+		void	init_sentinel(void) {
+			_end = _block_allocator.allocate(1);
+			new (_end) block();
+			_end->_next = _end;
+			_end->_previous = _end;
+		};
+
+		//Creates an empty block linked right after the given one
+		block*	create_block(block *after) {
+			block	*add = _block_allocator.allocate(1);
+
+			new (add) block();
+			add->_previous = after;
+			add->_next = after->_next;
+			after->_next->_previous = add;
+			after->_next = add;
+			return (add);
+		};
+
+		//Unlinks and frees a block which elements were already destroyed or moved out
+		void	destroy_block(block *old) {
+			old->_previous->_next = old->_next;
+			old->_next->_previous = old->_previous;
+			_block_allocator.deallocate(old, 1);
+		};
+
+		//Appends elements [from, _count) of src to dst (dst must have room) and shrinks src
+		void	move_elements(block *src, std::size_t from, block *dst) {
+			T	*source = src->content();
+
+			uninitialized_copy_a(source + from, source + src->_count, dst->content() + dst->_count, _allocator);
+			dst->_count += src->_count - from;
+			destroy_range_a(source + from, source + src->_count, _allocator);
+			src->_count = from;
+		};
+
+		/*
+		** Constructs value at index of a non full block, shifting the tail one slot to the right.
+		** If an assignment throws, the slot constructed past the tail is destroyed:
+		** the block keeps its count of valid elements.
+		*/
+		void	insert_at(block *node, std::size_t index, const T &value) {
+			T			*content = node->content();
+			std::size_t	i;
+
+			if (index == node->_count)
+				_allocator.construct(content + index, value);
+			else {
+				T	copy(value);
+
+				_allocator.construct(content + node->_count, content[node->_count - 1]);
+				try {
+					for (i = node->_count - 1; i > index; i--)
+						content[i] = content[i - 1];
+					content[index] = copy;
+				}
+				catch (...) {
+					_allocator.destroy(content + node->_count);
+					throw ;
+				}
+			}
+			node->_count++;
+		};
+
+		//Destroys the element at index, shifting the tail one slot to the left
+		void	erase_at(block *node, std::size_t index) {
+			T			*content = node->content();
+			std::size_t	i;
+
+			for (i = index; i + 1 < node->_count; i++)
+				content[i] = content[i + 1];
+			_allocator.destroy(content + node->_count - 1);
+			node->_count--;
+		};
+
+	//Member types
+	public:
+		typedef T												value_type;
+		typedef T												&reference;
+		typedef T												*pointer;
+		typedef std::size_t										size_type;
+		typedef const T											&const_reference;
+		typedef const T											*const_pointer;
+		typedef Allocator										allocator_type;
+		typedef ft::UnrolledIterator<T, K>						iterator;
+		typedef ft::UnrolledReverseIterator<T, K>				reverse_iterator;
+		typedef ft::UnrolledConstantIterator<T, K>				const_iterator;
+		typedef ft::UnrolledConstantReverseIterator<T, K>		const_reverse_iterator;
+		typedef typename ft::UnrolledIterator<T, K>::difference_type	difference_type;
+
+		//MEMBER FUNCTIONS
+		//Default constructor. Constructs an empty container with a default-constructed allocator.
+		unrolled_list(void) :
+			_allocator(allocator_type()), _block_allocator(_allocator), _size(0) {
+				init_sentinel();
+		};
+
+		//Constructs an empty container with the given allocator alloc.
+		explicit unrolled_list(const allocator_type &allocator) :
+			_allocator(allocator), _block_allocator(_allocator), _size(0) {
+				init_sentinel();
+		};
+
+		//Constructs the container with count copies of elements with value value.
+		explicit unrolled_list(size_type count, const_reference value = T(),
+			const allocator_type &allocator = allocator_type()) :
+			_allocator(allocator), _block_allocator(_allocator), _size(0) {
+				init_sentinel();
+				while (count--)
+					push_back(value);
+		};
+
+		//Constructs the container with the contents of the range [first, last).
+		template <class InputIt>
+		unrolled_list(InputIt first, InputIt last, const allocator_type &allocator = allocator_type()) :
+			_allocator(allocator), _block_allocator(_allocator), _size(0) {
+				init_sentinel();
+				assign<InputIt>(first, last);
+		};
+
+		//Copy constructor. Constructs the container with the copy of the contents of other
+		unrolled_list(const unrolled_list &copy) :
+			_allocator(copy._allocator), _block_allocator(_allocator), _size(0) {
+				init_sentinel();
+				assign(copy.begin(), copy.end());
+		};
+
+		//Destructor: destroys elements and releases every block
+		~unrolled_list(void) {
+			clear();
+			_block_allocator.deallocate(_end, 1);
+		};
+
+		//Replaces content of one container to another
+		unrolled_list&			operator=(const unrolled_list &other) {
+			if (this != &other)
+				assign(other.begin(), other.end());
+			return (*this);
+		};
+
+		//Replaces the contents with count copies of value
+		void					assign(size_type count, const_reference value) {
+			clear();
+			while (count--)
+				push_back(value);
+		};
+
+		void					assign(int count, const_reference value) {
+			if (count > 0) {
+				clear();
+				while (count--)
+					push_back(value);
+			}
+		};
+
+		//Replaces the contents with copies of those in the range [first, last)
+		template <class InputIt>
+		void					assign(InputIt first, InputIt last) {
+			clear();
+			for (; first != last; ++first)
+				push_back(*first);
+		};
+
+		//ELEMENT ACCESS METHODS
+		reference				front(void) {
+			return (_end->_next->content()[0]);
+		};
+
+		const_reference			front(void) const {
+			return (_end->_next->content()[0]);
+		};
+
+		reference				back(void) {
+			return (_end->_previous->content()[_end->_previous->_count - 1]);
+		};
+
+		const_reference			back(void) const {
+			return (_end->_previous->content()[_end->_previous->_count - 1]);
+		};
+
+		//ITERATORS METHODS
+		iterator				begin(void) {
+			return (iterator(_end->_next, 0));
+		};
+
+		iterator				end(void) {
+			return (iterator(_end, 0));
+		};
+
+		const_iterator			begin(void) const {
+			return (const_iterator(_end->_next, 0));
+		};
+
+		const_iterator			end(void) const {
+			return (const_iterator(_end, 0));
+		};
+
+		reverse_iterator		rbegin(void) {
+			if (!_size)
+				return (rend());
+			return (reverse_iterator(_end->_previous, _end->_previous->_count - 1));
+		};
+
+		reverse_iterator		rend(void) {
+			return (reverse_iterator(_end, 0));
+		};
+
+		const_reverse_iterator	rbegin(void) const {
+			if (!_size)
+				return (rend());
+			return (const_reverse_iterator(_end->_previous, _end->_previous->_count - 1));
+		};
+
+		const_reverse_iterator	rend(void) const {
+			return (const_reverse_iterator(_end, 0));
+		};
+
+		//CAPACITY: getting container size
+		bool					empty(void) const {
+			return (_size == 0);
+		};
+
+		size_type				size(void) const {
+			return (_size);
+		};
+
+		size_type				max_size(void) const {
+			return (std::numeric_limits<size_type>::max() / sizeof(T));
+		};
+
+		//MODIFIERS: work with container elements
+		void					clear(void) {
+			block		*node = _end->_next;
+			block		*next;
+
+			while (node != _end) {
+				next = node->_next;
+				destroy_range_a(node->content(), node->content() + node->_count, _allocator);
+				node->_count = 0;
+				destroy_block(node);
+				node = next;
+			}
+			_size = 0;
+		};
+
+		/*
+		** Inserts value before pos, returns iterator pointing to the inserted value.
+		** Insertion at the front of a block goes to the tail of the previous one when it has room,
+		** a full block is split in two halves first.
+		*/
+		iterator				insert(iterator pos, const_reference value) {
+			block		*node = pos.get_node();
+			std::size_t	index = pos.get_index();
+
+			if (!index && (node->_previous != _end) && !node->_previous->full()) {
+				node = node->_previous;
+				index = node->_count;
+			}
+			else if (node == _end) {
+				node = create_block(_end->_previous);
+				index = 0;
+			}
+			else if (node->full()) {
+				block	*add = create_block(node);
+
+				move_elements(node, K / 2, add);
+				if (index > node->_count) {
+					index -= node->_count;
+					node = add;
+				}
+			}
+			insert_at(node, index, value);
+			_size++;
+			return (iterator(node, index));
+		};
+
+		//Inserts count copies of value before pos
+		void					insert(iterator pos, size_type count, const_reference value) {
+			while (count--)
+				pos = ++insert(pos, value);
+		};
+
+		void					insert(iterator pos, int count, const_reference value) {
+			if (count > 0)
+				while (count--)
+					pos = ++insert(pos, value);
+		};
+
+		//Inserts elements from range [first, last) before pos.
+		template <class InputIt>
+		void					insert(iterator pos, InputIt first, InputIt last) {
+			for (; first != last; ++first)
+				pos = ++insert(pos, *first);
+		};
+
+		/*
+		** Removes the element at pos (the end() iterator cannot be used as a value for pos).
+		** An emptied block is released, a block left less than half full absorbs its successor
+		** when both fit in one block. Returns iterator following the removed element.
+		*/
+		iterator				erase(iterator pos) {
+			block		*node = pos.get_node();
+			std::size_t	index = pos.get_index();
+			block		*next = node->_next;
+
+			erase_at(node, index);
+			_size--;
+			if (!node->_count) {
+				destroy_block(node);
+				return (iterator(next, 0));
+			}
+			if ((node->_count < K / 2) && (next != _end)
+				&& (node->_count + next->_count <= K)) {
+				move_elements(next, 0, node);
+				destroy_block(next);
+			}
+			if (index < node->_count)
+				return (iterator(node, index));
+			return (iterator(node->_next, 0));
+		};
+
+		//Removes the elements in the range [first, last).
+		iterator				erase(iterator first, iterator last) {
+			size_type	count = 0;
+			iterator	it;
+
+			//Blocks get merged while erasing, so last is only valid to count the range
+			for (it = first; it != last; ++it)
+				count++;
+			while (count--)
+				first = erase(first);
+			return (first);
+		};
+
+		//Appends the given element value to the end of the container.
+		void					push_back(const_reference value) {
+			insert(end(), value);
+		};
+
+		//Removes the last element of the container. UB on empty list
+		void					pop_back(void) {
+			if (_size)
+				erase(iterator(_end->_previous, _end->_previous->_count - 1));
+		};
+
+		//Prepends the given element value to the beginning of the container.
+		void					push_front(const_reference value) {
+			insert(begin(), value);
+		};
+
+		//Removes the first element of the container. UB on empty list
+		void					pop_front(void) {
+			if (_size)
+				erase(begin());
+		};
+
+		//Resizes the container to contain count elements.
+		void					resize(size_type count, value_type value = T()) {
+			while (_size > count)
+				pop_back();
+			while (_size < count)
+				push_back(value);
+		};
+
+		//Exchanges the contents of the container with those of other.
+		//Only block chains are exchanged, elements are neither copied nor moved.
+		void					swap(unrolled_list &other) {
+			block			*tmp_end = _end;
+			std::size_t		tmp_size = _size;
+			Allocator		tmp_allocator = _allocator;
+			block_allocator	tmp_block_allocator = _block_allocator;
+
+			//Blocks go back to the allocator they came from: both allocators follow them
+			_end = other._end;
+			_size = other._size;
+			_allocator = other._allocator;
+			_block_allocator = other._block_allocator;
+			other._end = tmp_end;
+			other._size = tmp_size;
+			other._allocator = tmp_allocator;
+			other._block_allocator = tmp_block_allocator;
+		};
+
+		//OPERATIONS
+		//Removes all elements that are equal to value.
+		void					remove(const_reference value) {
+			remove_if(equal_to_value(value));
+		};
+
+		/*
+		** Removes all elements for which predicate p returns true.
+		** Every block is compacted in place, emptied blocks are released
+		** and neighbours that fit together are merged.
+		*/
+		template <class UnaryPredicate>
+		void					remove_if(UnaryPredicate p) {
+			block		*node = _end->_next;
+			block		*next;
+			std::size_t	kept;
+			std::size_t	i;
+
+			while (node != _end) {
+				T	*content = node->content();
+
+				next = node->_next;
+				kept = 0;
+				for (i = 0; i < node->_count; i++) {
+					if (!p(content[i])) {
+						if (kept != i)
+							content[kept] = content[i];
+						kept++;
+					}
+				}
+				destroy_range_a(content + kept, content + node->_count, _allocator);
+				_size -= node->_count - kept;
+				node->_count = kept;
+				if (!kept)
+					destroy_block(node);
+				else if ((node->_previous != _end)
+					&& (node->_previous->_count + kept <= K)) {
+					move_elements(node, 0, node->_previous);
+					destroy_block(node);
+				}
+				node = next;
+			}
+		};
+	};
+
+	//NON-MEMBER FUNCTIONS OVERLOAD
+	//Checks if the contents of lhs and rhs are equal.
+	template <class T, std::size_t K, class Alloc>
+	bool	operator==(const unrolled_list<T, K, Alloc> &lhs,
+		const unrolled_list<T, K, Alloc> &rhs) {
+		if (lhs.size() != rhs.size())
+			return (false);
+
+		typename unrolled_list<T, K, Alloc>::const_iterator	lit;
+		typename unrolled_list<T, K, Alloc>::const_iterator	rit = rhs.begin();
+
+		for (lit = lhs.begin(); lit != lhs.end(); lit++) {
+			if (*lit != *rit)
+				return (false);
+			rit++;
+		}
+		return (true);
+	};
+
+	//Checks if the contents of lhs and rhs are not equal.
+	template <class T, std::size_t K, class Alloc>
+	bool	operator!=(const unrolled_list<T, K, Alloc> &lhs,
+		const unrolled_list<T, K, Alloc> &rhs) {
+		return (!(lhs == rhs));
+	};
+
+	//Swaps the contents of lhs and rhs. Calls lhs.swap(rhs).
+	template <class T, std::size_t K, class Alloc>
+	void	swap(unrolled_list<T, K, Alloc> &lhs,
+		unrolled_list<T, K, Alloc> &rhs) {
+		lhs.swap(rhs);
+	};
+};
+
+#endif
@@ -0,0 +1,150 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench.cpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mskinner <v.golskiy@ya.ru>                 +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/06/28 10:12:44 by mskinner          #+#    #+#             */
+/*   Updated: 2021/06/28 10:12:44 by mskinner         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+//clang++ -Wall -Werror -Wextra -std=c++98 -pthread -O2 bench.cpp
+//Timings of the lists and their allocators, kept out of main.cpp so that the tests print the same output on every run
+
+#include "List.hpp"
+#include "UnrolledList.hpp"
+#include "ArenaAllocator.hpp"
+#include "PoolAllocator.hpp"
+#include "ThreadCachingAllocator.hpp"
+#include <sys/time.h>
+
+//Thread body: churns nodes through a list of List type, 100 elements long
+template <class List>
+void	*churn_nodes(void *operations) {
+	List	churned;
+	long	i;
+
+	for (i = 0; i < 100; i++)
+		churned.push_back(i);
+	for (i = 0; i < *static_cast<long *>(operations); i++) {
+		churned.push_back(i);
+		churned.pop_front();
+	}
+	return (NULL);
+}
+
+//Runs count threads of body and returns the wall time in milliseconds
+double	run_threads(void *(*body)(void *), int count, long operations) {
+	pthread_t		threads[64];
+	struct timeval	start;
+	struct timeval	stop;
+	int				i;
+
+	gettimeofday(&start, NULL);
+	for (i = 0; i < count; i++)
+		pthread_create(&threads[i], NULL, body, &operations);
+	for (i = 0; i < count; i++)
+		pthread_join(threads[i], NULL);
+	gettimeofday(&stop, NULL);
+	return ((stop.tv_sec - start.tv_sec) * 1000.0 + (stop.tv_usec - start.tv_usec) / 1000.0);
+}
+
+int main(void)
+{
+	int										i;
+	int										times;
+	ft::Arena								arena;
+	ft::ArenaAllocator<int>					arena_allocator(arena);
+
+	std::cout << "unrolled_list BENCHMARK (10 PASSES OVER 1000000 INTS) >>>" << std::endl;
+	ft::list<int>				blist;
+	ft::unrolled_list<int>		bulist;
+	long						bsum = 0;
+	long						busum = 0;
+	clock_t						bstart;
+	double						btime;
+
+	for (i = 0; i < 1000000; i++) {
+		blist.push_back(i);
+		bulist.push_back(i);
+	}
+	bstart = clock();
+	for (times = 0; times < 10; times++)
+		for (ft::list<int>::iterator bit = blist.begin(); bit != blist.end(); ++bit)
+			bsum += *bit;
+	btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+	std::cout << "ft_ list:          " << btime << " ms, ";
+	std::cout << sizeof(ft::Node<int>) << " bytes per element" << std::endl;
+	bstart = clock();
+	for (times = 0; times < 10; times++)
+		for (ft::unrolled_list<int>::iterator buit = bulist.begin(); buit != bulist.end(); ++buit)
+			busum += *buit;
+	btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+	std::cout << "ft_ unrolled_list: " << btime << " ms, ";
+	std::cout << static_cast<double>(sizeof(ft::UnrolledNode<int, 16>)) / 16 << " bytes per element" << std::endl;
+	std::cout << "same sums: " << (bsum == busum) << std::endl;
+
+	std::cout << std::endl << "ArenaAllocator BENCHMARK (10000 REQUESTS, 100 NODES EACH) >>>" << std::endl;
+	int		request;
+	bstart = clock();
+	for (request = 0; request < 10000; request++) {
+		ft::list<int>	scoped;
+
+		for (i = 0; i < 100; i++)
+			scoped.push_back(i);
+	}
+	//1000000 node allocations: milliseconds in total are nanoseconds per allocation
+	btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+	std::cout << "ft::Allocator:      " << btime << " ns per allocation" << std::endl;
+	bstart = clock();
+	for (request = 0; request < 10000; request++) {
+		{
+			ft::list<int, ft::ArenaAllocator<int> >	scoped(arena_allocator);
+
+			for (i = 0; i < 100; i++)
+				scoped.push_back(i);
+		}
+		arena.reset();
+	}
+	btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+	std::cout << "ft::ArenaAllocator: " << btime << " ns per allocation" << std::endl;
+
+	std::cout << std::endl << "PoolAllocator BENCHMARK (1000000 NODES CHURNED IN A 1000 NODES LIST) >>>" << std::endl;
+	ft::list<int>								churn;
+	ft::list<int, ft::PoolAllocator<int> >		pool_churn;
+	for (i = 0; i < 1000; i++) {
+		churn.push_back(i);
+		pool_churn.push_back(i);
+	}
+	bstart = clock();
+	for (i = 0; i < 1000000; i++) {
+		churn.push_back(i);
+		churn.pop_front();
+	}
+	//1000000 node allocations: milliseconds in total are nanoseconds per allocation
+	btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+	std::cout << "ft::Allocator:     " << btime << " ns per push_back/pop_front" << std::endl;
+	bstart = clock();
+	for (i = 0; i < 1000000; i++) {
+		pool_churn.push_back(i);
+		pool_churn.pop_front();
+	}
+	btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+	std::cout << "ft::PoolAllocator: " << btime << " ns per push_back/pop_front" << std::endl;
+
+	std::cout << std::endl << "ThreadCachingAllocator BENCHMARK (200000 NODES CHURNED PER THREAD) >>>" << std::endl;
+	int		threads;
+	long	churned = 200000;
+	double	ft_time;
+	double	tc_time;
+	for (threads = 1; threads <= 64; threads *= 2) {
+		ft_time = run_threads(churn_nodes<ft::list<int> >, threads, churned);
+		tc_time = run_threads(churn_nodes<ft::list<int, ft::ThreadCachingAllocator<int> > >, threads, churned);
+		std::cout << threads << " threads: ft::Allocator " << threads * churned / ft_time / 1000;
+		std::cout << " M/s, ft::ThreadCachingAllocator " << threads * churned / tc_time / 1000 << " M/s" << std::endl;
+	}
+
+	return (0);
+}
@@ -10,10 +10,20 @@
 /*                                                                            */
 /* ************************************************************************** */
 
-//clang++ -Wall -Werror -Wextra -std=c++98 main.cpp
+//clang++ -Wall -Werror -Wextra -std=c++98 -pthread main.cpp
 
 #include "List.hpp"
+#include "UnrolledList.hpp"
+#include "IntrusiveList.hpp"
+#include "ForwardList.hpp"
+#include "ArenaAllocator.hpp"
+#include "PoolAllocator.hpp"
+#include "ThreadCachingAllocator.hpp"
+#include "TrackingAllocator.hpp"
+#include "MemoryResource.hpp"
 #include <list>
+#include <stdexcept>
+#include <cstring>
 
 typedef bool	(*Compare)(const int &, const int &);
 
@@ -21,6 +31,66 @@ bool	compare(const int &val1, const int &val2) {
 	return (val1 < val2);
 }
 
+bool	is_odd(const int &val) {
+	return (val % 2);
+}
+
+bool	same_tens(const int &val1, const int &val2) {
+	return ((val1 / 10) == (val2 / 10));
+}
+
+//Element whose copy throws once copies_left reaches zero
+int	copies_left = -1;
+
+struct Fragile {
+	int	value;
+
+	Fragile(int val = 0) : value(val) {};
+	Fragile(const Fragile &copy) : value(copy.value) {
+		if (copies_left == 0)
+			throw std::runtime_error("copy failed");
+		if (copies_left > 0)
+			copies_left--;
+	};
+	Fragile&	operator=(const Fragile &other) {
+		value = other.value;
+		return (*this);
+	};
+};
+
+//Caller-owned element linked into ft::intrusive_list through its hook
+struct Timer {
+	int				id;
+	ft::ListHook	hook;
+
+	Timer(int value) : id(value), hook() {};
+};
+
+typedef ft::intrusive_list<Timer, &Timer::hook>	timer_list;
+
+bool	is_odd_timer(const Timer &timer) {
+	return (timer.id % 2);
+}
+
+void	printTimers(const timer_list &timers) {
+	timer_list::const_iterator			it;
+	timer_list::const_reverse_iterator	rit;
+
+	std::cout << "size: " << timers.size() << " [";
+	for (it = timers.begin(); it != timers.end(); ++it) {
+		if (it != timers.begin())
+			std::cout << ", ";
+		std::cout << it->id;
+	}
+	std::cout << "] in reverse: [";
+	for (rit = timers.rbegin(); rit != timers.rend(); ++rit) {
+		if (rit != timers.rbegin())
+			std::cout << ", ";
+		std::cout << rit->id;
+	}
+	std::cout << "]" << std::endl;
+}
+
 template <typename T>
 void    printContainer(ft::list<T> &cont) {
 	typename ft::list<T>::iterator it = cont.begin();
@@ -126,6 +196,32 @@ void    printConstantContainer(const T &cont) {
 	std::cout << "]" << std::endl;
 }
 
+//Thread body: builds a list whose nodes will be freed by another thread
+void	*build_shared(void *shared) {
+	ft::list<int, ft::ThreadCachingAllocator<int> >	*built =
+		static_cast<ft::list<int, ft::ThreadCachingAllocator<int> > *>(shared);
+	int												i;
+
+	for (i = 0; i < 1000; i++)
+		built->push_back(i);
+	return (NULL);
+}
+
+template <typename T>
+void    printForward(const T &cont) {
+	typename T::const_iterator it;
+
+	std::cout << "size: " << cont.size();
+	std::cout << " [";
+	for (it = cont.begin(); it != cont.end(); ++it)
+	{
+		if (it != cont.begin())
+			std::cout << ", ";
+		std::cout << *it;
+	}
+	std::cout << "]" << std::endl;
+}
+
 int main(void)
 {
 	std::srand(time(NULL));
@@ -418,7 +514,7 @@ int main(void)
 	std::cout << "ft_: before deleting of interval [last - 1, last): ";
 	printContainer(l12);
 	ft::list<float>::iterator it12 = l12.begin();
-	l12.erase(++(++(++(++it12))), l12.end());
+	it12 = l12.erase(++(++(++(++it12))), l12.end());
 	std::cout << "ft_: _after deleting of interval: ";
 	printContainer(l12);
 	std::cout << "ft_: list from the iterator position: ";
@@ -429,7 +525,7 @@ int main(void)
 	std::cout << "std: before deleting of interval: ";
 	printContainer(sl12);
 	std::list<float>::iterator sit12 = sl12.begin();
-	sl12.erase(++(++(++(++sit12))), sl12.end());
+	sit12 = sl12.erase(++(++(++(++sit12))), sl12.end());
 	std::cout << "std: _after deleting of interval: ";
 	printContainer(sl12);
 	std::cout << "std: list from the iterator position: ";
@@ -440,7 +536,7 @@ int main(void)
 	std::cout << "ft_: before deleting of interval [first, first + 2): ";
 	printContainer(l12);
 	it12 = l12.begin();
-	l12.erase(it12, ++(++it12));
+	it12 = l12.erase(it12, ++(++it12));
 	std::cout << "ft_: _after deleting of interval: ";
 	printContainer(l12);
 	std::cout << "ft_: list from the iterator position: ";
@@ -451,7 +547,7 @@ int main(void)
 	std::cout << "std: before deleting of interval: ";
 	printContainer(sl12);
 	sit12 = sl12.begin();
-	sl12.erase(sit12, ++(++sit12));
+	sit12 = sl12.erase(sit12, ++(++sit12));
 	std::cout << "std: _after deleting of interval: ";
 	printContainer(sl12);
 	std::cout << "std: list from the iterator position: ";
@@ -556,6 +652,36 @@ int main(void)
 	tmp.unique();
 	printContainer(tmp);
 
+	std::cout << std::endl << "list REMOVE_IF AND UNIQUE WITH PREDICATE TESTS >>>" << std::endl;
+	int				arr7[10] = {2, 1, 1, 3, 11, 12, 26, 21, 30, 30};
+	ft::list<int>	l21(arr7, arr7 + 10);
+	std::list<int>	sl21(arr7, arr7 + 10);
+	l21.remove(l21.back());
+	sl21.remove(sl21.back());
+	std::cout << "ft_ remove(back): ";
+	printContainer(l21);
+	std::cout << "std remove(back): ";
+	printContainer(sl21);
+	l21.unique(same_tens);
+	sl21.unique(same_tens);
+	std::cout << "ft_ unique(same_tens): ";
+	printContainer(l21);
+	std::cout << "std unique(same_tens): ";
+	printContainer(sl21);
+	l21.remove_if(is_odd);
+	sl21.remove_if(is_odd);
+	std::cout << "ft_ remove_if(is_odd): ";
+	printContainer(l21);
+	std::cout << "std remove_if(is_odd): ";
+	printContainer(sl21);
+
+	ft::list<int>	l22;
+	for (i = 0; i < 100000; i++)
+		l22.push_back(i % 4);
+	l22.remove_if(is_odd);
+	l22.remove(0);
+	std::cout << "ft_ 100000 elements filtered, left: " << l22.size() << std::endl;
+
 	std::cout << std::endl << "list MERGE TESTS >>>" << std::endl;
 	l18.assign(static_cast<std::size_t>(3), 99);
 	std::cout << "Original container 1:";
@@ -658,6 +784,40 @@ int main(void)
 	std::cout << "ft_: ";
 	printContainer(list1);
 
+	std::cout << std::endl << "list RANGE INSERT ROLLBACK TESTS >>>" << std::endl;
+	std::list<Fragile>				fragiles;
+	ft::list<Fragile>				fl;
+	ft::list<Fragile>::iterator		flrit;
+	for (i = 0; i < 10; i++)
+		fragiles.push_back(Fragile(i));
+	fl.insert(fl.end(), fragiles.begin(), fragiles.end());
+	copies_left = 4;
+	try {
+		fl.insert(++fl.begin(), fragiles.begin(), fragiles.end());
+	}
+	catch (std::exception &e) {
+		std::cout << "range insert threw: " << e.what() << std::endl;
+	}
+	copies_left = 2;
+	try {
+		fl.insert(fl.end(), static_cast<std::size_t>(5), Fragile(42));
+	}
+	catch (std::exception &e) {
+		std::cout << "count insert threw: " << e.what() << std::endl;
+	}
+	copies_left = -1;
+	std::cout << "list left unchanged, size: " << fl.size() << " [";
+	for (flrit = fl.begin(); flrit != fl.end(); ++flrit)
+		std::cout << flrit->value << ((flrit == --fl.end()) ? "" : ", ");
+	std::cout << "]" << std::endl;
+	fl.insert(++fl.begin(), 2, Fragile(7));
+	std::cout << "count insert after first, size: " << fl.size() << ", second: ";
+	std::cout << (++fl.begin())->value << ", fourth: " << (++(++(++fl.begin())))->value << std::endl;
+	copies_left = 100;
+	fl.push_back(Fragile(11));
+	std::cout << "copies of an element pushed back: " << 100 - copies_left << std::endl;
+	copies_left = -1;
+
 	std::cout << std::endl << "list COMPARISON TESTS >>>" << std::endl;
 	std::cout << "std lists for comparison: " << std::endl;
 	printContainer(sl13);
@@ -684,4 +844,447 @@ int main(void)
 	std::cout << "ft_: equal: " << (l10 == l13) << ", not equal: " << (l10 != l13);
 	std::cout << ", >: " << (l10 > l13) << ", >=: " << (l10 >= l13) << ", <: " << (l10 < l13);
 	std::cout << ", <=: " << (l10 <= l13) << std::endl;
+
+	std::cout << std::endl << "unrolled_list TESTS (4 ELEMENTS PER BLOCK) >>>" << std::endl;
+	ft::unrolled_list<int, 4>			ul1;
+	std::list<int>						sul1;
+	for (i = 0; i < 10; i++) {
+		ul1.push_back(i);
+		sul1.push_back(i);
+	}
+	for (i = 1; i < 4; i++) {
+		ul1.push_front(-i);
+		sul1.push_front(-i);
+	}
+	std::cout << "ft_: ";
+	printContainer(ul1);
+	std::cout << "std: ";
+	printContainer(sul1);
+
+	std::cout << "INSERT IN THE MIDDLE OF FULL BLOCKS >>>" << std::endl;
+	ft::unrolled_list<int, 4>::iterator	uit = ul1.begin();
+	std::list<int>::iterator			suit = sul1.begin();
+	for (i = 0; i < 5; i++) {
+		++uit;
+		++suit;
+	}
+	uit = ul1.insert(uit, 100);
+	suit = sul1.insert(suit, 100);
+	ul1.insert(uit, 3, 7);
+	sul1.insert(suit, 3, 7);
+	ul1.insert(ul1.end(), arr1, arr1 + 5);
+	sul1.insert(sul1.end(), arr1, arr1 + 5);
+	std::cout << "ft_: ";
+	printContainer(ul1);
+	std::cout << "std: ";
+	printContainer(sul1);
+
+	std::cout << "ERASE EVERY OTHER ELEMENT AND A RANGE >>>" << std::endl;
+	uit = ul1.begin();
+	while (uit != ul1.end()) {
+		uit = ul1.erase(uit);
+		if (uit != ul1.end())
+			++uit;
+	}
+	suit = sul1.begin();
+	while (suit != sul1.end()) {
+		suit = sul1.erase(suit);
+		if (suit != sul1.end())
+			++suit;
+	}
+	uit = ul1.erase(++ul1.begin(), --(--ul1.end()));
+	suit = sul1.erase(++sul1.begin(), --(--sul1.end()));
+	std::cout << "ft_: ";
+	printContainer(ul1);
+	std::cout << "std: ";
+	printContainer(sul1);
+	std::cout << "ft_ returned: " << *uit << ", std returned: " << *suit << std::endl;
+
+	std::cout << "REMOVE, REMOVE_IF, POP AND COPY >>>" << std::endl;
+	ft::unrolled_list<int, 4>	ul2(static_cast<std::size_t>(9), 4);
+	std::list<int>				sul2(static_cast<std::size_t>(9), 4);
+	ul2.push_back(6);
+	sul2.push_back(6);
+	ul2.push_front(3);
+	sul2.push_front(3);
+	ul2.remove(ul2.back());
+	sul2.remove(sul2.back());
+	ul2.remove_if(is_odd);
+	sul2.remove_if(is_odd);
+	std::cout << "ft_: ";
+	printContainer(ul2);
+	std::cout << "std: ";
+	printContainer(sul2);
+	ft::unrolled_list<int, 4>		ul3(arr5, arr5 + 6);
+	const ft::unrolled_list<int, 4>	constul3(ul3);
+	ul3.pop_back();
+	ul3.pop_front();
+	std::cout << "ft_: ";
+	printContainer(ul3);
+	std::cout << "ftc: ";
+	printConstantContainer(constul3);
+	std::cout << "copy equal: " << (ul3 == constul3) << ", not equal: " << (ul3 != constul3) << std::endl;
+	ul3.swap(ul2);
+	std::cout << "after swap: ";
+	printContainer(ul3);
+
+	std::cout << std::endl << "intrusive_list TESTS >>>" << std::endl;
+	Timer		timers[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+	timer_list	active;
+	timer_list	expired;
+
+	for (i = 0; i < 4; i++)
+		active.push_back(timers[i]);
+	active.push_front(timers[4]);
+	std::cout << "pushed 0-3 back, 4 front: ";
+	printTimers(active);
+	active.erase(timers[2]);
+	std::cout << "erased by reference 2 (linked: " << timers[2].hook.linked() << "): ";
+	printTimers(active);
+	active.insert(active.iterator_to(timers[1]), timers[5]);
+	std::cout << "inserted 5 before iterator_to(1): ";
+	printTimers(active);
+	active.iterator_to(timers[3])->id = 33;
+	std::cout << "changed 3 through iterator_to: ";
+	printTimers(active);
+	expired.push_back(timers[6]);
+	expired.push_back(timers[7]);
+	expired.splice(expired.begin(), active, active.iterator_to(timers[0]));
+	std::cout << "spliced element 0 into expired: ";
+	printTimers(expired);
+	expired.splice(expired.end(), active, active.begin(), active.iterator_to(timers[1]));
+	std::cout << "spliced range [begin, 1) into expired: ";
+	printTimers(expired);
+	std::cout << "active left: ";
+	printTimers(active);
+	expired.remove_if(is_odd_timer);
+	std::cout << "expired after remove_if(odd): ";
+	printTimers(expired);
+	ft::swap(active, expired);
+	std::cout << "after swap, active: ";
+	printTimers(active);
+	std::cout << "after swap, expired: ";
+	printTimers(expired);
+	active.splice(active.end(), expired);
+	active.pop_front();
+	active.pop_back();
+	std::cout << "merged, popped front and back: ";
+	printTimers(active);
+	active.clear();
+	std::cout << "cleared, elements still alive and unlinked: ";
+	for (i = 0; i < 8; i++)
+		std::cout << timers[i].id << (timers[i].hook.linked() ? "+ " : "- ");
+	std::cout << std::endl;
+
+	std::cout << std::endl << "forward_list TESTS >>>" << std::endl;
+	ft::forward_list<int>					fl1(arr5, arr5 + 6);
+	std::list<int>							sfl1(arr5, arr5 + 6);
+	ft::forward_list<int>::iterator			flit = fl1.before_begin();
+	fl1.push_front(42);
+	sfl1.push_front(42);
+	std::cout << "ft_: ";
+	printForward(fl1);
+	std::cout << "std: ";
+	printForward(sfl1);
+	flit = fl1.insert_after(fl1.begin(), 3, 8);
+	fl1.insert_after(flit, arr1, arr1 + 3);
+	fl1.erase_after(fl1.before_begin());
+	std::cout << "inserted 3x8 and arr1[0..2] after front, erased front: ";
+	printForward(fl1);
+	flit = fl1.begin();
+	++flit;
+	fl1.erase_after(flit, fl1.end());
+	std::cout << "erased after second element: ";
+	printForward(fl1);
+	fl1.resize(5, 1);
+	std::cout << "resized to 5: ";
+	printForward(fl1);
+
+	std::cout << "SORT, UNIQUE, REMOVE_IF, REVERSE >>>" << std::endl;
+	ft::forward_list<int>	fl2(arr7, arr7 + 10);
+	std::list<int>			sfl2(arr7, arr7 + 10);
+	fl2.sort();
+	sfl2.sort();
+	std::cout << "ft_: ";
+	printForward(fl2);
+	std::cout << "std: ";
+	printForward(sfl2);
+	fl2.unique();
+	sfl2.unique();
+	fl2.remove_if(is_odd);
+	sfl2.remove_if(is_odd);
+	fl2.reverse();
+	sfl2.reverse();
+	std::cout << "ft_: ";
+	printForward(fl2);
+	std::cout << "std: ";
+	printForward(sfl2);
+	fl2.sort(compare);
+	fl2.unique(same_tens);
+	std::cout << "sorted with compare, unique tens: ";
+	printForward(fl2);
+
+	std::cout << "MERGE, SPLICE_AFTER, SWAP >>>" << std::endl;
+	ft::forward_list<int>	fl3(arr1, arr1 + 5);
+	ft::forward_list<int>	fl4(arr5, arr5 + 6);
+	fl3.sort();
+	fl4.sort();
+	fl3.merge(fl4);
+	std::cout << "merged: ";
+	printForward(fl3);
+	std::cout << "merged from: ";
+	printForward(fl4);
+	fl4.push_front(-1);
+	fl4.push_front(-2);
+	fl4.splice_after(fl4.begin(), fl3, fl3.before_begin());
+	std::cout << "spliced front of merged after first: ";
+	printForward(fl4);
+	flit = fl3.begin();
+	++flit;
+	++flit;
+	fl4.splice_after(fl4.before_begin(), fl3, fl3.begin(), flit);
+	std::cout << "spliced one element range to front: ";
+	printForward(fl4);
+	fl4.splice_after(fl4.before_begin(), fl3);
+	std::cout << "spliced the rest to front: ";
+	printForward(fl4);
+	std::cout << "emptied: ";
+	printForward(fl3);
+	ft::swap(fl3, fl4);
+	const ft::forward_list<int>	constfl(fl3);
+	std::cout << "swapped, const copy: ";
+	printForward(constfl);
+	std::cout << "copy equal: " << (constfl == fl3) << ", not equal: " << (constfl != fl4) << std::endl;
+	ft::forward_list<Fragile>	ffl(fragiles.begin(), fragiles.end());
+	copies_left = 4;
+	try {
+		ffl.insert_after(ffl.begin(), fragiles.begin(), fragiles.end());
+	}
+	catch (std::exception &e) {
+		std::cout << "range insert_after threw: " << e.what();
+	}
+	copies_left = 2;
+	try {
+		ft::forward_list<Fragile>	thrown(static_cast<std::size_t>(5), Fragile(42));
+	}
+	catch (std::exception &e) {
+		std::cout << ", count constructor threw: " << e.what();
+	}
+	copies_left = -1;
+	std::cout << ", size left: " << ffl.size() << ", second: " << (++ffl.begin())->value << std::endl;
+	copies_left = 100;
+	ffl.push_front(Fragile(11));
+	std::cout << "copies of an element pushed front: " << 100 - copies_left << std::endl;
+	copies_left = -1;
+
+	std::cout << "UNCOUNTED forward_list, 100000 ELEMENTS SORTED >>>" << std::endl;
+	ft::forward_list<int, ft::Allocator<int>, false>	fl5;
+	std::list<int>										sfl5;
+	for (i = 0; i < 100000; i++) {
+		times = std::rand() % 1000;
+		fl5.push_front(times);
+		sfl5.push_front(times);
+	}
+	fl5.sort();
+	sfl5.sort();
+	ft::forward_list<int, ft::Allocator<int>, false>::iterator	flit5 = fl5.begin();
+	std::list<int>::iterator									sflit5 = sfl5.begin();
+	while ((sflit5 != sfl5.end()) && (*flit5 == *sflit5)) {
+		++flit5;
+		++sflit5;
+	}
+	std::cout << "same size: " << (fl5.size() == sfl5.size());
+	std::cout << ", same order: " << (flit5 == fl5.end()) << std::endl;
+	std::cout << "bytes per node, ft_ forward_list: " << sizeof(ft::ForwardNode<void *>);
+	std::cout << ", ft_ list: " << sizeof(ft::Node<void *>) << std::endl;
+	std::cout << "bytes of the list itself, counted: " << sizeof(ft::forward_list<int>);
+	std::cout << ", uncounted: " << sizeof(ft::forward_list<int, ft::Allocator<int>, false>) << std::endl;
+
+	std::cout << std::endl << "ArenaAllocator TESTS >>>" << std::endl;
+	char												arena_buffer[4096];
+	ft::Arena											arena(arena_buffer, sizeof(arena_buffer), 16 * 1024);
+	ft::ArenaAllocator<int>								arena_allocator(arena);
+	{
+		ft::list<int, ft::ArenaAllocator<int> >			al1(arena_allocator);
+
+		std::cout << "sentinels of an empty list, bytes from arena: " << arena.allocated() << std::endl;
+		ft::list<int, ft::ArenaAllocator<int> >			al2(arr5, arr5 + 6, arena_allocator);
+		for (i = 0; i < 10; i++)
+			al1.push_back(i);
+		al1.remove_if(is_odd);
+		al1.swap(al2);
+		al1.sort();
+		std::cout << "ft_: ";
+		printContainer(al1);
+		std::cout << "ft_: ";
+		printContainer(al2);
+		std::cout << "rebound allocators share the arena: ";
+		std::cout << (ft::ArenaAllocator<ft::Node<int> >(arena_allocator) == arena_allocator) << std::endl;
+		std::cout << "bytes from arena: " << arena.allocated() << ", heap chunks: " << arena.chunks() << std::endl;
+		for (i = 0; i < 1000; i++)
+			al1.push_back(i);
+		std::cout << "after 1000 more, heap chunks: " << arena.chunks() << std::endl;
+	}
+	//The lists are gone, sentinels included, before their memory is reused
+	arena.reset();
+	std::cout << "after reset, bytes from arena: " << arena.allocated() << ", heap chunks: " << arena.chunks() << std::endl;
+
+	std::cout << std::endl << "PoolAllocator TESTS >>>" << std::endl;
+	ft::list<int, ft::PoolAllocator<int> >			pl1(arr5, arr5 + 6);
+	ft::list<int, ft::PoolAllocator<int> >			pl2(pl1);
+	ft::forward_list<int, ft::PoolAllocator<int> >	pfl(arr1, arr1 + 5);
+	pl1.sort();
+	pl2.remove_if(is_odd);
+	pl1.swap(pl2);
+	pfl.reverse();
+	std::cout << "ft_: ";
+	printContainer(pl1);
+	std::cout << "ft_: ";
+	printContainer(pl2);
+	std::cout << "ft_: ";
+	printForward(pfl);
+	ft::list<int, ft::PoolAllocator<int> >	*pool_source = new ft::list<int, ft::PoolAllocator<int> >(pl1);
+	pl1.splice(pl1.begin(), *pool_source);
+	delete pool_source;
+	std::cout << "nodes spliced from a destroyed list ft_: ";
+	printContainer(pl1);
+	ft::list<int, ft::PoolAllocator<int> >	*foreign = new ft::list<int, ft::PoolAllocator<int> >(arr1, arr1 + 5);
+	pl1.splice(pl1.begin(), *foreign, foreign->begin());
+	pl1.splice(pl1.begin(), *foreign, foreign->begin(), ++(++foreign->begin()));
+	pl1.splice(pl1.end(), *foreign);
+	std::cout << "other pools, left in the source: " << foreign->size() << std::endl;
+	delete foreign;
+	std::cout << "elements spliced from a destroyed list of other pools ft_: ";
+	printContainer(pl1);
+	foreign = new ft::list<int, ft::PoolAllocator<int> >(arr5, arr5 + 6);
+	foreign->sort();
+	pl1.sort();
+	pl1.merge(*foreign);
+	delete foreign;
+	std::cout << "merged from a destroyed list of other pools ft_: ";
+	printContainer(pl1);
+	ft::forward_list<int, ft::PoolAllocator<int> >	*foreign_fl = new ft::forward_list<int, ft::PoolAllocator<int> >(arr1, arr1 + 5);
+	pfl.splice_after(pfl.before_begin(), *foreign_fl, foreign_fl->begin());
+	pfl.splice_after(pfl.before_begin(), *foreign_fl, foreign_fl->before_begin(), ++foreign_fl->begin());
+	pfl.splice_after(pfl.begin(), *foreign_fl);
+	pfl.sort();
+	delete foreign_fl;
+	foreign_fl = new ft::forward_list<int, ft::PoolAllocator<int> >(arr5, arr5 + 6);
+	foreign_fl->sort();
+	pfl.merge(*foreign_fl);
+	delete foreign_fl;
+	std::cout << "forward_list spliced and merged from destroyed lists of other pools ft_: ";
+	printForward(pfl);
+	ft::PoolAllocator<ft::Node<int>, 1024>	pool_nodes;
+	ft::Node<int>							*pool_slots[1000];
+	for (i = 0; i < 1000; i++)
+		pool_slots[i] = pool_nodes.allocate(1);
+	std::cout << "node slot size: " << pool_nodes.pool().slot_size();
+	std::cout << ", 1000 slots in slabs: " << pool_nodes.pool().slabs() << std::endl;
+	for (i = 0; i < 1000; i += 2)
+		pool_nodes.deallocate(pool_slots[i], 1);
+	pool_nodes.trim();
+	std::cout << "every other slot freed and trimmed, slabs: " << pool_nodes.pool().slabs() << std::endl;
+	for (i = 1; i < 1000; i += 2)
+		pool_nodes.deallocate(pool_slots[i], 1);
+	std::cout << "reused slot: " << (pool_nodes.allocate(1) == pool_slots[999]) << std::endl;
+	pool_nodes.trim();
+	std::cout << "all slots but the reused one freed and trimmed, slabs: " << pool_nodes.pool().slabs() << std::endl;
+
+	std::cout << std::endl << "ThreadCachingAllocator TESTS >>>" << std::endl;
+	ft::list<int, ft::ThreadCachingAllocator<int> >	tl1(arr5, arr5 + 6);
+	ft::list<int, ft::ThreadCachingAllocator<int> >	tl2;
+	pthread_t										builder;
+	std::size_t										node_bytes = sizeof(ft::Node<int>);
+	tl1.sort();
+	std::cout << "ft_: ";
+	printContainer(tl1);
+	pthread_create(&builder, NULL, build_shared, &tl2);
+	pthread_join(builder, NULL);
+	std::cout << "built by another thread, size: " << tl2.size() << ", front: " << tl2.front();
+	std::cout << ", back: " << tl2.back() << std::endl;
+	std::cout << "central blocks after the builder exit: " << ft::ThreadHeap::central(node_bytes) << std::endl;
+	tl2.clear();
+	std::cout << "freed by this thread, cached here: " << ft::ThreadHeap::cached(node_bytes);
+	std::cout << ", central: " << ft::ThreadHeap::central(node_bytes) << std::endl;
+
+	std::cout << std::endl << "TrackingAllocator TESTS >>>" << std::endl;
+	ft::TrackingAllocator<int>												tracker;
+	ft::list<int, ft::TrackingAllocator<int> >								tkl1(tracker);
+	ft::list<int, ft::TrackingAllocator<int> >								tkl2(arr5, arr5 + 6,
+		ft::TrackingAllocator<int>("sessions"));
+	ft::forward_list<int, ft::TrackingAllocator<int, ft::PoolAllocator<int> > >	tkfl(arr1, arr1 + 5,
+		ft::TrackingAllocator<int, ft::PoolAllocator<int> >("cache"));
+	for (i = 0; i < 100; i++)
+		tkl1.push_back(i);
+	tkl1.remove_if(is_odd);
+	std::cout << "per instance, ";
+	tracker.stats().print(std::cout);
+	std::cout << std::endl;
+	tkl2.pop_back();
+	tkfl.push_front(0);
+	{
+		ft::list<int, ft::TrackingAllocator<int> >	tkl3(static_cast<std::size_t>(3), 7,
+			ft::TrackingAllocator<int>("sessions"));
+
+		std::cout << "two lists under one tag, live bytes: ";
+		std::cout << ft::AllocationRegistry::stats("sessions").bytes_live << std::endl;
+	}
+	{
+		char	tag_buffer[16];
+
+		std::strcpy(tag_buffer, "requests");
+		ft::TrackingAllocator<int>	requests(tag_buffer);
+
+		requests.deallocate(requests.allocate(4), 4);
+		std::strcpy(tag_buffer, "overwritten");
+	}
+	std::cout << "registry report:" << std::endl;
+	ft::AllocationRegistry::report(std::cout);
+	std::cout << "unknown tag found: " << (ft::AllocationRegistry::find("unknown") != NULL) << std::endl;
+
+	std::cout << std::endl << "memory_resource TESTS >>>" << std::endl;
+	char								stack_buffer[1024];
+	ft::monotonic_buffer_resource		monotonic(stack_buffer, sizeof(stack_buffer));
+	ft::unsynchronized_pool_resource	pooled;
+	ft::pmr::list<int>::type			pml1(arr5, arr5 + 6, &monotonic);
+	ft::pmr::list<int>::type			pml2(arr1, arr1 + 5, &pooled);
+	ft::pmr::list<int>::type			pml3(static_cast<std::size_t>(3), 7);
+	ft::pmr::forward_list<int>::type	pmfl(arr1, arr1 + 5, &pooled);
+	char								*front_address;
+	void								*large;
+	pml1.sort();
+	std::cout << "monotonic: ";
+	printContainer(pml1);
+	front_address = reinterpret_cast<char *>(&pml1.front());
+	std::cout << "node in the stack buffer: ";
+	std::cout << ((front_address >= stack_buffer) && (front_address < stack_buffer + sizeof(stack_buffer))) << std::endl;
+	std::cout << "pool: ";
+	printContainer(pml2);
+	std::cout << "new/delete: ";
+	printContainer(pml3);
+	pml2.swap(pml3);
+	std::cout << "one type for every resource, swapped: ";
+	printContainer(pml2);
+	std::cout << "resources follow the swap: " << (pml2.get_allocator().resource() == ft::new_delete_resource());
+	std::cout << " " << (pml3.get_allocator().resource() == &pooled) << std::endl;
+	pmfl.reverse();
+	std::cout << "forward_list from the pool: ";
+	printForward(pmfl);
+	pml3.clear();
+	pml3.push_back(42);
+	std::cout << "largest pooled block: " << pooled.options().largest_required_pool_block << std::endl;
+	large = pooled.allocate(10000);
+	pooled.deallocate(large, 10000);
+	std::cout << "oversized request served upstream" << std::endl;
+	{
+		ft::memory_resource			*previous = ft::set_default_resource(&monotonic);
+		ft::pmr::list<int>::type	pml4;
+
+		pml4.push_back(1);
+		std::cout << "default resource replaced: " << (pml4.get_allocator().resource() == &monotonic) << std::endl;
+		ft::set_default_resource(previous);
+	}
+	std::cout << "polymorphic allocators equal: " << (pml1.get_allocator() == ft::polymorphic_allocator<int>(&monotonic));
+	std::cout << " " << (pml1.get_allocator() == pml3.get_allocator()) << std::endl;
 };
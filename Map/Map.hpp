@@ -15,6 +15,11 @@
 ** Keys are sorted by using the comparison function Compare.
 ** Search, removal, and insertion operations have logarithmic complexity.
 ** Maps are usually implemented as red-black trees.
+** The last parameter augments the tree (see TreePolicy.hpp): with ft::order_statistics,
+** rank(), select() and the distance between iterators take logarithmic time,
+** with ft::monoid_summary<Monoid>, aggregate() over a key range does.
+** split(), join() and the set operations relink the nodes of red-black trees
+** instead of inserting elements one by one.
 */
 
 #pragma once
@@ -25,13 +30,17 @@
 # include "Iterator.hpp"
 
 namespace ft {
-	template <typename Key, typename T, class Compare = std::less<Key> , class Allocator = std::allocator<std::pair<const Key, T> > >
+	template <typename Key, typename T, class Compare = std::less<Key> , class Allocator = std::allocator<std::pair<const Key, T> >,
+		class Augment = ft::plain_tree >
 	class map {
 
 	private:
-		Allocator		_allocator;
-		Compare			_compare;
-		RBTree<Key, T>	*_tree;
+		typedef RBTree<Key, T, Compare, Allocator, Augment>	tree_type;
+
+		Allocator							_allocator;
+		Compare								_compare;
+		//Embedded tree: its nodes come from _allocator rebound to the node type
+		tree_type							_tree;
 
 	//https://en.cppreference.com/w/cpp/container/map
 	//Member types
@@ -46,11 +55,15 @@ namespace ft {
 		typedef value_type										*pointer;
 		typedef const value_type								&const_reference;
 		typedef const value_type								*const_pointer;
-		typedef ft::Iterator<Key, T>							iterator;
+		typedef typename Augment::template iterator<ft::Iterator<Key, T>,
+			typename tree_type::node_type>::type				iterator;
 		typedef ft::ReverseIterator<Key, T>						reverse_iterator;
-		typedef ft::ConstantIterator<Key, T>					const_iterator;
+		typedef typename Augment::template iterator<ft::ConstantIterator<Key, T>,
+			typename tree_type::node_type>::type				const_iterator;
 		typedef ft::ConstantReverseIterator<Key, T>				const_reverse_iterator;
 		typedef typename ft::Iterator<Key, T>::difference_type	difference_type;
+		//Summary of a range of elements under the augmentation policy, void for ft::plain_tree
+		typedef typename Augment::summary_type					summary_type;
 
 		//https://en.cppreference.com/w/cpp/container/map/value_compare
 		// value_compare is a function object that compares objects of value_type
@@ -82,44 +95,34 @@ namespace ft {
 		//https://en.cppreference.com/w/cpp/container/map/map
 		//MEMBER FUNCTIONS
 		//Default constructor. Constructs an empty container with a default-constructed allocator.
-		map(void) : _allocator(allocator_type()), _compare() {
-			_tree = new RBTree<Key, T>();
-		};
+		map(void) : _allocator(allocator_type()), _compare(), _tree(_compare, _allocator) {};
 		
 		//Constructs an empty container with the given allocator.
 		explicit map(const Compare& compare, const Allocator& allocator = Allocator()) :
-			_allocator(allocator), _compare(compare) {
-				_tree = new RBTree<Key, T>();
-			};
+			_allocator(allocator), _compare(compare), _tree(_compare, _allocator) {};
 
 		//Constructs the container with the contents of the range [first, last).
 		template <class InputIt>
 		map(InputIt first, InputIt last, const Compare& compare = Compare(), const Allocator& allocator = Allocator()) :
-			_allocator(allocator), _compare(compare) {
-				_tree = new RBTree<Key, T>();
+			_allocator(allocator), _compare(compare), _tree(_compare, _allocator) {
 				insert(first, last);
 			};
 
 		//Copy constructor. Constructs the container with the copy of the contents of other
-		map(const map &copy) : _allocator(copy._allocator), _compare(copy._compare) {
-			_tree = new RBTree<Key, T>();
-			insert(copy.begin(), copy.end());
-		};
+		//The tree is cloned node for node in linear time.
+		map(const map &copy) : _allocator(copy._allocator), _compare(copy._compare), _tree(copy._tree) {};
 
 		//https://en.cppreference.com/w/cpp/container/map/%7Emap
-		//Destructor: clears allocator and deletes list elements
-		~map(void) {
-			delete _tree;
-		};
+		//Destructor: the embedded tree gives its nodes back to the allocator
+		~map(void) {};
 
 		//https://en.cppreference.com/w/cpp/container/map/operator%3D
-		//Replaces content of one container to another
+		//Replaces content of one container to another, cloning the tree of other in linear time.
+		//The allocator is kept: the nodes of the copy come from it, as the ones of the former content did.
 		map&						operator=(const map &other) {
 			if (this != &other) {
-				_allocator = other._allocator;
 				_compare = other._compare;
-				clear();
-				insert(other.begin(), other.end());
+				_tree = other._tree;
 			}
 			return (*this);
 		};
@@ -129,126 +132,114 @@ namespace ft {
 		//Returns a reference to the value that is mapped to a key 
 		//equivalent to key, performing an insertion if such key does not already exist.
 		T&							operator[](const Key &key) {
-			iterator	it = find(key);
-
-			if (it == end())
-				return (insert(std::make_pair(key, T())).first->second);
-			return (it->second);
+			return (_tree.insert_unique(key, T()).first->_content.second);
 		};
 
 		//ITERATORS METHODS
 		//https://en.cppreference.com/w/cpp/container/vector
 		//If tree is empty return end()
 		iterator					begin(void) {
-			if (_tree->_root)
-				return (iterator(_tree->_end_left->_parent));
+			if (_tree._root)
+				return (iterator(_tree._end_left->parent()));
 			else
-				return (iterator(_tree->_end_right));
+				return (iterator(_tree._end_right));
 		};
 
 		iterator					end(void) {
-			return (iterator(_tree->_end_right));
+			return (iterator(_tree._end_right));
 		};
 
 		const_iterator				begin(void) const {
-			if (_tree->_root)
-				return (const_iterator(_tree->_end_left->_parent));
+			if (_tree._root)
+				return (const_iterator(_tree._end_left->parent()));
 			else
-				return (const_iterator(_tree->_end_right));			
+				return (const_iterator(_tree._end_right));			
 		};
 
 		const_iterator				end(void) const {
-			return (const_iterator(_tree->_end_right));
+			return (const_iterator(_tree._end_right));
 		};
 
 		reverse_iterator			rbegin(void) {
-			if (_tree->_root)
-				return (reverse_iterator(_tree->_end_right->_parent));
+			if (_tree._root)
+				return (reverse_iterator(_tree._end_right->parent()));
 			else
-				return (reverse_iterator(_tree->_end_left));
+				return (reverse_iterator(_tree._end_left));
 		};
 
 		reverse_iterator			rend(void) {
-			return (reverse_iterator(_tree->_end_left));
+			return (reverse_iterator(_tree._end_left));
 		};
 
 		const_reverse_iterator		rbegin(void) const {
-			if (_tree->_root)
-				return (const_reverse_iterator(_tree->_end_right->_parent));
+			if (_tree._root)
+				return (const_reverse_iterator(_tree._end_right->parent()));
 			else
-				return (const_reverse_iterator(_tree->_end_left));
+				return (const_reverse_iterator(_tree._end_left));
 		};
 
 		const_reverse_iterator		rend(void) const {
-			return (const_reverse_iterator(_tree->_end_left));
+			return (const_reverse_iterator(_tree._end_left));
 		};
 		
 		//CAPACITY: getting container size
 		//https://en.cppreference.com/w/cpp/container/map/empty
 		//Checks if the container has no elements, i.e. whether begin() == end().
 		bool						empty(void) const {
-			return (!_tree->_size);
+			return (!_tree._size);
 		};
 
 		//https://en.cppreference.com/w/cpp/container/map/size
 		//Returns the number of elements in the container, i.e. std::distance(begin(), end()).
 		size_type					size(void) const {
-			return (_tree->_size);
+			return (_tree._size);
 		};
 
 		//https://en.cppreference.com/w/cpp/container/map/max_size
 		//Returns the maximum number of elements the container is able to hold due to system or library implementation limitations.
 		size_type					max_size(void) const {
-			return (std::numeric_limits<size_type>::max() / sizeof(ft::Node<key_type, mapped_type>));
+			return (std::numeric_limits<size_type>::max() / sizeof(typename tree_type::node_type));
 		};
 
 		//MODIFIERS METHODS
 		//https://en.cppreference.com/w/cpp/container/map/clear
 		//Erases all elements from the container. After this call, size() returns zero.
 		void						clear(void) {
-			_tree->clear();
+			_tree.clear();
 		};
 
 		//https://en.cppreference.com/w/cpp/container/map/insert
-		//Inserts value, returns iterator pointing to the inserted value.
+		//Inserts value, returns iterator pointing to the inserted value
+		//or to the element with an equivalent key, which is left as it is.
 		std::pair<iterator,bool>	insert(const value_type& value) {
-			Node<Key, T>	*tmp = _tree->search(value.first);
-			Key				key = value.first;
+			std::pair<Node<Key, T> *, bool>	inserted = _tree.insert_unique(value.first, value.second);
 
-			if (tmp && (tmp != _tree->_end_left)
-				&& (tmp != _tree->_end_right))
-				return (std::make_pair(iterator(tmp), false));
-			_tree->insert(value.first, value.second);
-			tmp = _tree->search(key);
-			return (std::make_pair(iterator(tmp), true));
+			return (std::make_pair(iterator(inserted.first), inserted.second));
 		};
 
 		/*
 		** Inserts value in the position as close as possible to hint.
-		** The function optimizes its insertion time if position points
-		** to the element that will precede the inserted element.
+		** The insertion takes amortized constant time when the key goes
+		** right before or right after the element at hint, as when appending
+		** increasing keys with end() as hint, logarithmic time otherwise.
 		** Notice that this is just a hint and does not force the new element
 		** to be inserted at that position within the map container
 		** (the elements in a map always follow a specific order depending on their key).
 		*/
 		iterator					insert(iterator hint, const value_type& value) {
-			Node<Key, T>	*tmp = _tree->search(value.first);
-			iterator		it = upper_bound(value.first);
-			
-			if (tmp && (tmp != _tree->_end_left)
-				&& (tmp != _tree->_end_right))
-				return (iterator(tmp));
-			if ((!_tree->_root) || (hint->first > it->first))
-				return (iterator(_tree->insert(value.first, value.second)));
-			return (iterator(_tree->insert(hint.get_root(), value.first, value.second)));
+			return (iterator(_tree.insert_hint(hint.get_root(), value.first, value.second).first));
 		};
 
 		//Inserts elements from range [first, last).
 		//If multiple elements in the range have keys that compare equivalent, it is unspecified which element is inserted.
+		//Into an empty map, the run of strictly increasing keys the range starts with is built into a balanced tree
+		//in linear time, the elements after it are appended with end() as hint.
 		template < class InputIt >
 		void						insert(InputIt first, InputIt last) {
+			if (empty())
+				first = _tree.build_sorted(first, last);
 			while (first != last) {
-				insert(*first);
+				insert(end(), *first);
 				first++;
 			}
 		};
@@ -256,29 +247,26 @@ namespace ft {
 		//https://en.cppreference.com/w/cpp/container/map/erase
 		//Removes the element at pos.
 		void						erase(iterator pos) {
-			_tree->erase(pos.get_root()->_content.first);
+			_tree.erase_node(pos.get_root());
 		};
 
 		//Removes the elements in the range [first; last), which must be a valid range in *this.
+		//Linear in the number of elements removed, the whole map is cleared at once.
 		void						erase(iterator first, iterator last) {
-			Key	current = first->first;
-			Key	end = last->first;
-
-			while (current != end)
-				current = _tree->erase(current);
+			_tree.erase_range(first.get_root(), last.get_root());
 		};
 
 		//Removes the element (if one exists) with the key equivalent to key.
+		//Returns the number of elements removed: 0 or 1.
 		size_type					erase(const key_type &key) {
-			_tree->erase(key);
-			return (_tree->_size);
+			return (_tree.erase(key));
 		};
 
 		//https://en.cppreference.com/w/cpp/container/map/swap
 		//Exchanges the contents of the container with those of other.
 		//Does not invoke any move, copy, or swap operations on individual elements.
 		void						swap(map& other) {
-			swap_element(_tree, other._tree);
+			_tree.swap(other._tree);
 			swap_element(_allocator, other._allocator);
 			swap_element(_compare, other._compare);
 		};
@@ -288,21 +276,25 @@ namespace ft {
 		//Returns the number of elements with key that compares equivalent to the specified argument,
 		//which is either 1 or 0 since this container does not allow duplicates.
 		size_type					count(const Key &key) const {
-			return (_tree->count(key));
+			return (_tree.count(key));
 		};
 
 		//https://en.cppreference.com/w/cpp/container/map/find
 		//Finds an element with key equivalent to key.
 		iterator					find(const Key &key) {
-			Node<Key, T>	*tmp = _tree->search(key);
+			Node<Key, T>	*tmp = _tree.search(key);
 			
 			if (tmp)
 				return (iterator(tmp));
-			return (iterator(_tree->_end_right));
+			return (end());
 		};
 
 		const_iterator				find(const Key &key) const {
-			return (const_iterator(_tree->search(key)));
+			Node<Key, T>	*tmp = _tree.search(key);
+
+			if (tmp)
+				return (const_iterator(tmp));
+			return (end());
 		};
 
 		//https://en.cppreference.com/w/cpp/container/map/equal_range
@@ -324,60 +316,130 @@ namespace ft {
 
 		//https://en.cppreference.com/w/cpp/container/map/lower_bound
 		//Returns an iterator pointing to the first element that is not less than (i.e. greater or equal to) key.
+		//Logarithmic: a single descent of the tree with key_comp().
 		iterator					lower_bound(const Key &key) {
-			iterator	it = begin();
-			Compare		compare;
-
-			while ((it != end()) && (compare(it->first, key)))
-				it++;
-			return (it);
+			return (iterator(_tree.lower_bound(key)));
 		};
 
 		const_iterator				lower_bound(const Key &key) const {
-			const_iterator	it = begin();
-			Compare			compare;
-
-			while ((it != end()) && (compare(it->first, key)))
-				it++;
-			return (it);
+			return (const_iterator(_tree.lower_bound(key)));
 		};
 
 		//https://en.cppreference.com/w/cpp/container/map/upper_bound
 		//Returns an iterator pointing to the first element that is greater than key.
 		iterator					upper_bound(const Key &key) {
-			iterator	it = begin();
-			Compare		compare;
-
-			while ((it != end()) && (compare(it->first, key)))
-				it++;
-			if ((it != end()) && (it->first == key))
-				return (++it);
-			return (it);
+			return (iterator(_tree.upper_bound(key)));
 		};
 
 		const_iterator				upper_bound(const Key &key) const {
-			const_iterator	it = begin();
-			Compare			compare;
+			return (const_iterator(_tree.upper_bound(key)));
+		};
+
+		//ORDER STATISTICS METHODS, for maps augmented with ft::order_statistics
+		//Returns the number of elements with a key less than key, in O(log n).
+		size_type					rank(const Key &key) const {
+			return (_tree.rank(key));
+		};
+
+		//Returns an iterator to the element at position index in key order, end() if index >= size(), in O(log n).
+		iterator					select(size_type index) {
+			return (iterator(_tree.select(index)));
+		};
+
+		const_iterator				select(size_type index) const {
+			return (const_iterator(_tree.select(index)));
+		};
+
+		//Same as select(): nth(size() * 99 / 100) is the 99th percentile key.
+		iterator					nth(size_type index) {
+			return (select(index));
+		};
+
+		const_iterator				nth(size_type index) const {
+			return (select(index));
+		};
+
+		//AGGREGATE METHODS, for maps augmented with ft::monoid_summary or ft::order_statistics
+		//Returns the summary of all the elements, in constant time.
+		summary_type				aggregate(void) const {
+			return (_tree.aggregate());
+		};
+
+		//Returns the summary of the elements with keys in [lo, hi), combined in key order, in O(log n).
+		//The identity of the monoid if there is none.
+		summary_type				aggregate(const Key &lo, const Key &hi) const {
+			return (_tree.aggregate(lo, hi));
+		};
+
+		//Summaries read the values: once the value at pos is changed in place, through operator[]
+		//or an iterator, refresh(pos) summarizes it again, in O(log n).
+		void						refresh(iterator pos) {
+			_tree.refresh(pos.get_root());
+		};
+
+		//SPLIT, JOIN AND SET OPERATIONS: nodes move between maps, whose allocators must compare equal
+		//Moves the elements with keys not less than key into right, whose former content is erased.
+		//Relinking takes O(log n), the sizes O(log n) with ft::order_statistics, else linear in the smaller part.
+		void						split(const Key &key, map &right) {
+			if (&right == this)
+				return ;
+			right.clear();
+			right._compare = _compare;
+			right._tree._compare = _compare;
+			_tree.split(key, right._tree);
+		};
+
+		//Moves all the elements of other into this map in O(log n) when the keys of one map are all
+		//less than the keys of the other. Otherwise as set_union(): elements with keys already here stay in other.
+		void						join(map &other) {
+			if ((&other == this) || other.empty())
+				return ;
+			if (empty() || _compare(_tree._end_right->parent()->_content.first,
+				other._tree._end_left->parent()->_content.first))
+				_tree.join(other._tree);
+			else if (_compare(other._tree._end_right->parent()->_content.first,
+				_tree._end_left->parent()->_content.first)) {
+				other._tree.join(_tree);
+				_tree.swap(other._tree);
+			}
+			else
+				set_union(other);
+		};
+
+		//Moves the elements of other with keys not in this map into it, the others stay in other
+		//(as map::merge() of C++17). O(m log(n / m + 1)) for sizes m <= n, instead of m insertions.
+		void						set_union(map &other) {
+			_tree.merge_unique(other._tree);
+		};
+
+		//Erases the elements with keys not in other, which is left as it is.
+		//O(m log(n / m + 1)) for sizes m <= n, plus the erasures.
+		void						set_intersection(const map &other) {
+			_tree.intersect(other._tree);
+		};
+
+		//Erases the elements with keys in other, which is left as it is.
+		void						set_difference(const map &other) {
+			_tree.subtract(other._tree);
+		};
 
-			while ((it != end()) && (compare(it->first, key)))
-				it++;
-			if ((it != end()) && (it->first == key))
-				return (++it);
-			return (it);
+		//Returns the allocator associated with the container.
+		allocator_type				get_allocator(void) const {
+			return (_allocator);
 		};
 
 		//OBSERVERS METHODS
 		//Returns the function object that compares the keys,
 		//which is a copy of this container's constructor argument comp.
 		key_compare					key_comp(void) const {
-			return (Compare());
+			return (_compare);
 		};
 
 		//https://en.cppreference.com/w/cpp/container/map/value_comp
 		//Returns a function object that compares objects of type std::map::value_type (key-value pairs)
 		//by using key_comp to compare the first components of the pairs.
 		value_compare				value_comp(void) const {
-			return (value_compare());
+			return (value_compare(_compare));
 		};
 	};
 
@@ -389,14 +451,14 @@ namespace ft {
 	** each element in lhs compares equal with the element
 	** in rhs at the same position.
 	*/
-	template <class Key, class T, class Compare, class Alloc>
-	bool	operator==(const map<Key, T, Compare, Alloc> &lhs,
-		const map<Key, T, Compare, Alloc> &rhs) {
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	bool	operator==(const map<Key, T, Compare, Alloc, Augment> &lhs,
+		const map<Key, T, Compare, Alloc, Augment> &rhs) {
 		if (lhs.size() != rhs.size())
 			return (false);
 	
-		typename map<Key, T, Compare, Alloc>::const_iterator	lit;
-		typename map<Key, T, Compare, Alloc>::const_iterator	rit = rhs.begin();
+		typename map<Key, T, Compare, Alloc, Augment>::const_iterator	lit;
+		typename map<Key, T, Compare, Alloc, Augment>::const_iterator	rit = rhs.begin();
 	
 		for (lit = lhs.begin(); lit != lhs.end(); lit++) {
 			if (*lit != *rit)
@@ -407,23 +469,23 @@ namespace ft {
 	};
 	
 	//Checks if the contents of lhs and rhs are not equal.
-	template <class Key, class T, class Compare, class Alloc>
-	bool	operator!=(const map<Key, T, Compare, Alloc> &lhs,
-		const map<Key, T, Compare, Alloc> &rhs) {
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	bool	operator!=(const map<Key, T, Compare, Alloc, Augment> &lhs,
+		const map<Key, T, Compare, Alloc, Augment> &rhs) {
 		return (!(rhs == lhs));
 	};
 	
 	//Compares the contents of lhs and rhs lexicographically.
-	template <class Key, class T, class Compare, class Alloc>
-	bool	operator<(const map<Key, T, Compare, Alloc> &lhs,
-		const map<Key, T, Compare, Alloc> &rhs) {
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	bool	operator<(const map<Key, T, Compare, Alloc, Augment> &lhs,
+		const map<Key, T, Compare, Alloc, Augment> &rhs) {
 		if ((!lhs.size() && !rhs.size()) || (!rhs.size()))
 			return (false);
 		if (!lhs.size())
 			return (true);
 	
-		typename map<Key, T, Compare, Alloc>::const_iterator	lit = lhs.begin();
-		typename map<Key, T, Compare, Alloc>::const_iterator	rit = rhs.begin();
+		typename map<Key, T, Compare, Alloc, Augment>::const_iterator	lit = lhs.begin();
+		typename map<Key, T, Compare, Alloc, Augment>::const_iterator	rit = rhs.begin();
 	
 		while ((lit != lhs.end()) && (rit != rhs.end())) {
 			if (*lit < *rit)
@@ -437,23 +499,23 @@ namespace ft {
 	};
 	
 	//Compares the contents of lhs and rhs lexicographically.
-	template <class Key, class T, class Compare, class Alloc>
-	bool	operator<=( const map<Key, T, Compare, Alloc> &lhs,
-		const map<Key, T, Compare, Alloc> &rhs ) {
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	bool	operator<=( const map<Key, T, Compare, Alloc, Augment> &lhs,
+		const map<Key, T, Compare, Alloc, Augment> &rhs ) {
 		return ((lhs < rhs) || (lhs == rhs));
 	};
 	
 	//Compares the contents of lhs and rhs lexicographically.
-	template <class Key, class T, class Compare, class Alloc>
-	bool	operator>(const map<Key, T, Compare, Alloc> &lhs,
-		const map<Key, T, Compare, Alloc> &rhs) {
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	bool	operator>(const map<Key, T, Compare, Alloc, Augment> &lhs,
+		const map<Key, T, Compare, Alloc, Augment> &rhs) {
 		return (!(lhs <= rhs));
 	};
 	
 	//Compares the contents of lhs and rhs lexicographically.
-	template <class Key, class T, class Compare, class Alloc>
-	bool	operator>=(const map<Key, T, Compare, Alloc> &lhs,
-		const map<Key, T, Compare, Alloc> &rhs) {
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	bool	operator>=(const map<Key, T, Compare, Alloc, Augment> &lhs,
+		const map<Key, T, Compare, Alloc, Augment> &rhs) {
 		return (!(lhs < rhs));
 	};
 	
@@ -461,9 +523,9 @@ namespace ft {
 	** Specializes the std::swap algorithm for std::list.
 	** Swaps the contents of lhs and rhs. Calls lhs.swap(rhs).
 	*/
-	template <class Key, class T, class Compare, class Alloc>
-	void	swap(map<Key, T, Compare, Alloc> &lhs,
-				 map<Key, T, Compare, Alloc> &rhs) {
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	void	swap(map<Key, T, Compare, Alloc, Augment> &lhs,
+				 map<Key, T, Compare, Alloc, Augment> &rhs) {
 		lhs.swap(rhs);
 	};
 
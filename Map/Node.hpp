@@ -19,75 +19,98 @@
 
 namespace ft
 {
-	enum color_t {BLACK, RED, END};
+	//A node is red or black, sentinels are told apart by their address
+	enum color_t {BLACK, RED};
 
 	template <typename T>
 	void	swap_element(T &x, T &y) {
-		T	tmp;
+		T	tmp(x);
 
-		tmp = x;
 		x = y;
 		y = tmp;
 	};
 
+	/*
+	** Node of a red-black tree: three words of links, then the key and the value.
+	** The color lives in the lowest bit of the parent address, always zero as nodes
+	** are aligned on pointers: a map<int, int> node takes 32 bytes instead of 40,
+	** and the key sits right after the links, in the first cache line of the node.
+	*/
 	template < typename Key, typename T >
 	class Node
 	{
+	private:
+		std::size_t			_parent_color;
+
 	public:
-		Node				*_parent;
 		Node				*_left;
 		Node				*_right;
 		std::pair<Key, T>	_content;
-		enum color_t		_color;
 	
-		Node() : _parent(NULL), _left(NULL), _right(NULL), _content(), _color(RED) {};
+		Node() : _parent_color(RED), _left(NULL), _right(NULL), _content() {};
 		Node(const Key &key, const T &content) :
-			_parent(NULL), _left(NULL), _right(NULL) {
-				_content = std::make_pair(key, content);
-				_color = RED;
-			};
+			_parent_color(RED), _left(NULL), _right(NULL), _content(key, content) {};
 		Node(const Node &copy) :
-			_parent(copy._parent), _left(copy._left), _right(copy._right), _content(copy._content),
-			_color(copy._color) {};
+			_parent_color(copy._parent_color), _left(copy._left), _right(copy._right),
+			_content(copy._content) {};
 		~Node() {};
 		Node&	operator=(const Node &other) {
 			if (this != &other) {
-				_parent = other._previous;
-				_left = other._next;
+				_parent_color = other._parent_color;
+				_left = other._left;
 				_right = other._right;
 				_content = other._content;
-				_color = other._color;
 			}
 			return (*this);
 		};
-		
+
+		Node*	parent(void) const {
+			return (reinterpret_cast<Node *>(_parent_color & ~static_cast<std::size_t>(1)));
+		};
+
+		void	set_parent(Node *parent) {
+			_parent_color = reinterpret_cast<std::size_t>(parent) | (_parent_color & 1);
+		};
+
+		color_t	color(void) const {
+			return (static_cast<color_t>(_parent_color & 1));
+		};
+
+		void	set_color(color_t color) {
+			_parent_color = (_parent_color & ~static_cast<std::size_t>(1)) | color;
+		};
+
 		//Searching for a brother between parent children
 		Node*	sibling(void) {
-			if (!_parent)
+			if (!parent())
 				return (NULL);
 			if (isLeft())
-				return (_parent->_right);
-			return (_parent->_left);
+				return (parent()->_right);
+			return (parent()->_left);
 		};
 		
 		bool	isLeft(void) {
-			return (this == _parent->_left);
+			return (this == parent()->_left);
 		};
 
 		bool	hasRedChild(void) {
-			return ((_left && (_left->_color == RED))
-					|| (_right && (_right->_color == RED)));
+			return ((_left && (_left->color() == RED))
+					|| (_right && (_right->color() == RED)));
 		};
 
-		//Finds node in current subtree that does not have a left child
+		/*
+		** Finds node in current subtree that does not have a left child.
+		** The leftmost node of the tree is never in the right subtree of another node:
+		** stepping from a node, the walk stops on the sentinel below the extreme node only.
+		*/
 		Node*	minimum(Node *current) {
-			while ((current->_left) && (current->_left->_color != END))
+			while (current->_left)
 				current = current->_left;
 			return (current);
 		};
 		
 		Node*	maximum(Node *current) {
-			while ((current->_right) && (current->_right->_color != END))
+			while (current->_right)
 				current = current->_right;
 			return (current);
 		};
@@ -105,10 +128,10 @@ namespace ft
 			** Else it is the lowest ancestor of current node whose
 			** right child is also an ancestor of current node
 			*/
-			Node	*parent = current->_parent;
+			Node	*parent = current->parent();
 			while (parent && (current == parent->_right)) {
 				current = parent;
-				parent = parent->_parent;
+				parent = parent->parent();
 			}
 			return (parent);
 		};
@@ -126,14 +149,23 @@ namespace ft
 			** Else it is the lowest ancestor of current node whose
 			** left child is also an ancestor of current node
 			*/
-			Node	*parent = current->_parent;
+			Node	*parent = current->parent();
 			while (parent && (current == parent->_left)) {
 				current = parent;
-				parent = parent->_parent;
+				parent = parent->parent();
 			}
 			return (parent);
 		};
 	};
+
+	//Exchanges the colors of two nodes
+	template < typename Key, typename T >
+	void	swap_colors(Node<Key, T> *x, Node<Key, T> *y) {
+		color_t	color = x->color();
+
+		x->set_color(y->color());
+		y->set_color(color);
+	};
 };
 
 #endif
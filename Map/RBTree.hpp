@@ -15,61 +15,152 @@
 #ifndef _RBTREE_HPP_
 # define _RBTREE_HPP_
 
-# include "Node.hpp"
+# include "TreePolicy.hpp"
 
 namespace ft
 {		
-	template < typename Key, typename T, class Compare = std::less<Key> >
+	template < typename Key, typename T, class Compare = std::less<Key>,
+		class Allocator = std::allocator<std::pair<const Key, T> >, class Augment = plain_tree >
 	class RBTree
 	{
 	public:
+		//Node type of the augmentation policy (see TreePolicy.hpp), a Node<Key, T> itself by default
+		typedef typename Augment::template node<Key, T>::type				node_type;
+		//Allocator rebound to the node type: nodes and sentinels are taken from and returned to it
+		typedef typename Allocator::template rebind<node_type>::other		node_allocator;
+
 		Node<Key, T>	*_root;
 		Node<Key, T>	*_end_left;
 		Node<Key, T>	*_end_right;
 		size_t			_size;
+		node_allocator	_node_allocator;
+		//Ordering of the keys: every descent goes through it, keys are never compared with ==
+		Compare			_compare;
 
-		RBTree() : _root(NULL), _size(0) {
-			_end_left = new Node<Key, T>();
-			_end_left->_color = END;
-			_end_right = new Node<Key, T>();
-			_end_right->_color = END;
+		explicit RBTree(const Compare &compare = Compare(), const Allocator &allocator = Allocator()) :
+			_root(NULL), _size(0), _node_allocator(allocator), _compare(compare) {
+			create_sentinels();
 		};
-		RBTree(const Key &key, const T &content) : _root(NULL), _size(0) {
+		RBTree(const Key &key, const T &content, const Allocator &allocator = Allocator()) :
+			_root(NULL), _size(0), _node_allocator(allocator), _compare() {
+			create_sentinels();
 			insert(key, content);
 		};
-		RBTree(const RBTree &copy) : _root(NULL), _size(0) {
-			copy(copy._root);
+		RBTree(const RBTree &other) : _root(NULL), _size(0), _node_allocator(other._node_allocator),
+			_compare(other._compare) {
+			create_sentinels();
+			try {
+				clone(other);
+			}
+			catch (...) {
+				destroy_node(_end_left);
+				destroy_node(_end_right);
+				throw ;
+			}
 		};
 		~RBTree() {
 			clear();
-			delete _end_left;
-			delete _end_right;
+			destroy_node(_end_left);
+			destroy_node(_end_right);
 		};
+		//Nodes keep coming from this tree's allocator. If a copy throws, the tree is left empty.
 		RBTree& operator=(const RBTree &other) {
 			if (this != &other) {
 				clear();
-				_root = NULL;
-				copy(other._root);
+				_compare = other._compare;
+				clone(other);
 			}
 			return (*this);
 		};
 
+		//Exchanges nodes, sentinels and allocators: nodes go back to the allocator they came from
+		void	swap(RBTree &other) {
+			swap_element(_root, other._root);
+			swap_element(_end_left, other._end_left);
+			swap_element(_end_right, other._end_right);
+			swap_element(_size, other._size);
+			swap_element(_node_allocator, other._node_allocator);
+			swap_element(_compare, other._compare);
+		};
+
 	private:
-		//Filling tree
-		Node<Key, T>*	RBTInsert(Node<Key, T> *root, Node<Key, T> *current, Compare compare = Compare()) {
-			//Inserting the first node, if not root
-			if (!root)
-				return (current);
-			//Otherwise, performing recursion down the tree
-			if (compare(root->_content.first, current->_content.first)) {
-				root->_right = RBTInsert(root->_right, current);
-				root->_right->_parent = root;
+		//Allocates and constructs a detached red node holding a copy of key and value
+		Node<Key, T>*	create_node(const Key &key, const T &value) {
+			return (create_node(node_type(key, value)));
+		};
+
+		//Allocates and constructs a copy of model, links, color and augmentation included
+		Node<Key, T>*	create_node(const node_type &model) {
+			node_type	*node = _node_allocator.allocate(1);
+
+			try {
+				_node_allocator.construct(node, model);
 			}
-			else {
-				root->_left = RBTInsert(root->_left, current);
-				root->_left->_parent = root;
+			catch (...) {
+				_node_allocator.deallocate(node, 1);
+				throw ;
 			}
-			return (root);
+			return (node);
+		};
+
+		void			destroy_node(Node<Key, T> *node) {
+			_node_allocator.destroy(static_cast<node_type *>(node));
+			_node_allocator.deallocate(static_cast<node_type *>(node), 1);
+		};
+
+		//Recomputes the augmentation of node from its children, nothing for plain_tree
+		void			update(Node<Key, T> *node) {
+			if (Augment::augmented)
+				Augment::update(static_cast<node_type *>(node));
+		};
+
+		//Recomputes the augmentation of node and of its ancestors, bottom-up
+		void			update_path(Node<Key, T> *node) {
+			if (Augment::augmented)
+				for (; node; node = node->parent())
+					Augment::update(static_cast<node_type *>(node));
+		};
+
+		/*
+		** Sentinels are black leaves to the rebalancing, is_nil() knows them by their address.
+		** Their augmentation is the one of an empty subtree.
+		*/
+		void			create_sentinels(void) {
+			_end_left = create_node(Key(), T());
+			_end_left->set_color(BLACK);
+			try {
+				_end_right = create_node(Key(), T());
+			}
+			catch (...) {
+				destroy_node(_end_left);
+				throw ;
+			}
+			_end_right->set_color(BLACK);
+			if (Augment::augmented) {
+				Augment::clear(static_cast<node_type *>(_end_left));
+				Augment::clear(static_cast<node_type *>(_end_right));
+			}
+		};
+
+		//A missing child or a sentinel: the tree ends there
+		bool			is_nil(Node<Key, T> *node) const {
+			return (!node || (node == _end_left) || (node == _end_right));
+		};
+
+		/*
+		** Filling tree: descends from root to the free place of current, a key equal
+		** to the one of a node goes to its left, then links current there
+		*/
+		Node<Key, T>*	RBTInsert(Node<Key, T> *root, Node<Key, T> *current) {
+			Node<Key, T>	*parent = NULL;
+			bool			left = true;
+
+			while (!is_nil(root)) {
+				parent = root;
+				left = !_compare(root->_content.first, current->_content.first);
+				root = left ? root->_left : root->_right;
+			}
+			return (link_node(parent, left, current));
 		};
 
 		void	rotateLeft(Node<Key, T> *&root, Node<Key, T> *&current) {
@@ -77,16 +168,18 @@ namespace ft
 
 			current->_right = current->_right->_left;
 			if (current->_right)
-				current->_right->_parent = current;
-			current_right->_parent = current->_parent;
-			if (!current->_parent)
+				current->_right->set_parent(current);
+			current_right->set_parent(current->parent());
+			if (!current->parent())
 				root = current_right;
-			else if (current == current->_parent->_left)
-				current->_parent->_left = current_right;
+			else if (current == current->parent()->_left)
+				current->parent()->_left = current_right;
 			else
-				current->_parent->_right = current_right;
+				current->parent()->_right = current_right;
 			current_right->_left = current;
-			current->_parent = current_right;
+			current->set_parent(current_right);
+			update(current);
+			update(current_right);
 		};
 
 		void	rotateRight(Node<Key, T> *&root, Node<Key, T> *&current) {
@@ -94,37 +187,39 @@ namespace ft
 
 			current->_left = current->_left->_right;
 			if (current->_left)
-				current->_left->_parent = current;
-			current_left->_parent = current->_parent;
-			if (!current->_parent)
+				current->_left->set_parent(current);
+			current_left->set_parent(current->parent());
+			if (!current->parent())
 				root = current_left;
-			else if (current == current->_parent->_left)
-				current->_parent->_left = current_left;
+			else if (current == current->parent()->_left)
+				current->parent()->_left = current_left;
 			else
-				current->_parent->_right = current_left;
+				current->parent()->_right = current_left;
 			current_left->_right = current;
-			current->_parent = current_left;
+			current->set_parent(current_left);
+			update(current);
+			update(current_left);
 		};
 
-		//Fixing violations caused by BST insertion
-		void	fixViolation(Node<Key, T> *&root, Node<Key, T> *&current) {
+		//Fixing violations caused by BST insertion, true if the root was red: the black height grew
+		bool	fixViolation(Node<Key, T> *&root, Node<Key, T> *&current) {
 			Node<Key, T>	*parent = NULL;
 			Node<Key, T>	*grandparent = NULL;
 
-			while (current && (current->_color != BLACK)
-			&& (current->_parent) && (current->_parent->_color == RED)) {
-				parent = current->_parent;
-				grandparent = current->_parent->_parent;
+			while (current && (current->color() != BLACK)
+			&& (current->parent()) && (current->parent()->color() == RED)) {
+				parent = current->parent();
+				grandparent = current->parent()->parent();
 
 			//A: Parent of pt is left child  of Grand-parent of pt
 				if (parent == grandparent->_left) {
 					Node<Key, T> *uncle = grandparent->_right;
 					
 				//1) The uncle of pt is also red (recoloring only)
-					if (uncle && (uncle->_color == RED)) {
-						grandparent->_color = RED;
-						parent->_color = BLACK;
-						uncle->_color = BLACK;
+					if (uncle && (uncle->color() == RED)) {
+						grandparent->set_color(RED);
+						parent->set_color(BLACK);
+						uncle->set_color(BLACK);
 						current = grandparent;
 					}
 					else {
@@ -132,11 +227,11 @@ namespace ft
 						if (current == parent->_right) {
 							rotateLeft(root, parent);
 							current = parent;
-							parent = current->_parent;
+							parent = current->parent();
 						}
 				//3) pt is left child of its parent (right-rotation required)
 						rotateRight(root, grandparent);
-						swap_element(parent->_color, grandparent->_color);
+						swap_colors(parent, grandparent);
 						current = parent;
 		            }
 		        } 
@@ -145,10 +240,10 @@ namespace ft
 					Node<Key, T>	*uncle = grandparent->_left; 
 
 		        //1) The uncle of pt is also red (recoloring only)
-					if (uncle && (uncle->_color == RED)) {
-						grandparent->_color = RED;
-						parent->_color = BLACK;
-						uncle->_color = BLACK;
+					if (uncle && (uncle->color() == RED)) {
+						grandparent->set_color(RED);
+						parent->set_color(BLACK);
+						uncle->set_color(BLACK);
 						current = grandparent; 
 		            } 
 		            else
@@ -157,266 +252,454 @@ namespace ft
 						if (current == parent->_left) {
 							rotateRight(root, parent);
 							current = parent;
-							parent = current->_parent;
+							parent = current->parent();
 						}
 						
 				//3) pt is right child of its parent (left-rotation required)
 						rotateLeft(root, grandparent);
-						swap_element(parent->_color, grandparent->_color);
+						swap_colors(parent, grandparent);
 						current = parent;
 					}
 				}
 			}
-			root->_color = BLACK;
+			if (root->color() == BLACK)
+				return (false);
+			root->set_color(BLACK);
+			return (true);
 		};
 
 		Node<Key, T>*	RBTReplace(Node<Key, T> *old) {
 			//Node is a leaf
-			if (!old->_left && !old->_right)
+			if (is_nil(old->_left) && is_nil(old->_right))
 				return (NULL);
 			//Node has both children
-			if (old->_left && old->_right)
+			if (!is_nil(old->_left) && !is_nil(old->_right))
 				return (minimum(old->_right));
 			//Node has one child
-			if (!old->_left)
+			if (is_nil(old->_left))
 				return (old->_right);
 			else
 				return (old->_left);
 		};
 		
+		//Restores black heights once fix has lost a black node below it, moving up the tree as needed
 		void	fixBlacks(Node<Key, T> *fix) {
-			if (fix == _root)
-				return ;
+			Node<Key, T>	*sibling;
+			Node<Key, T>	*parent;
 
-			Node<Key, T>*	sibling = fix->sibling();
-			Node<Key, T>*	parent = fix->_parent;
-			
-			if (!sibling)
-				fixBlacks(parent);
-			else {
-				if (sibling->_color == RED) {
-					parent->_color = RED;
-					sibling->_color = BLACK;
+			while (fix != _root) {
+				sibling = fix->sibling();
+				parent = fix->parent();
+				if (!sibling) {
+					fix = parent;
+					continue ;
+				}
+				if (sibling->color() == RED) {
+					parent->set_color(RED);
+					sibling->set_color(BLACK);
 					if (sibling->isLeft())
 						rotateRight(_root, parent);
 					else
 						rotateLeft(_root, parent);
-					fixBlacks(fix);
+					continue ;
 				}
-				else {
-					if (sibling->hasRedChild()) {
-						if (sibling->_left && (sibling->_left->_color == RED)) {
-							if (sibling->isLeft()) {
-								sibling->_left->_color = sibling->_color;
-								sibling->_color = parent->_color;
-								rotateRight(_root, parent);
-							}
-							else {
-								sibling->_left->_color = parent->_color;
-								rotateRight(_root, sibling);
-								rotateLeft(_root, parent);
-							}
+				if (sibling->hasRedChild()) {
+					if (sibling->_left && (sibling->_left->color() == RED)) {
+						if (sibling->isLeft()) {
+							sibling->_left->set_color(sibling->color());
+							sibling->set_color(parent->color());
+							rotateRight(_root, parent);
 						}
 						else {
-							if (sibling->isLeft()) {
-								sibling->_right->_color = parent->_color;
-								rotateLeft(_root, sibling);
-								rotateRight(_root, parent);
-							}
-							else {
-								sibling->_right->_color = sibling->_color;
-								sibling->_color = parent->_color;
-								rotateLeft(_root, parent);
-							}
+							sibling->_left->set_color(parent->color());
+							rotateRight(_root, sibling);
+							rotateLeft(_root, parent);
 						}
-						parent->_color = BLACK;
 					}
 					else {
-						sibling->_color = RED;
-						if (parent->_color == BLACK)
-							fixBlacks(parent);
-						else
-							parent->_color = BLACK;
+						if (sibling->isLeft()) {
+							sibling->_right->set_color(parent->color());
+							rotateLeft(_root, sibling);
+							rotateRight(_root, parent);
+						}
+						else {
+							sibling->_right->set_color(sibling->color());
+							sibling->set_color(parent->color());
+							rotateLeft(_root, parent);
+						}
 					}
+					parent->set_color(BLACK);
+					return ;
+				}
+				sibling->set_color(RED);
+				if (parent->color() == RED) {
+					parent->set_color(BLACK);
+					return ;
 				}
+				fix = parent;
 			}
 		};
 
+		/*
+		** Exchanges the places of old, which has two children, and of next,
+		** the leftmost node of its right subtree, colors included:
+		** nodes are relinked, contents stay where they are.
+		*/
+		void	swapWithSuccessor(Node<Key, T> *old, Node<Key, T> *next) {
+			Node<Key, T>	*parent = old->parent();
+			Node<Key, T>	*next_right = next->_right;
+
+			next->_left = old->_left;
+			next->_left->set_parent(next);
+			if (next == old->_right) {
+				next->_right = old;
+				old->set_parent(next);
+			}
+			else {
+				next->parent()->_left = old;
+				old->set_parent(next->parent());
+				next->_right = old->_right;
+				next->_right->set_parent(next);
+			}
+			old->_left = NULL;
+			old->_right = next_right;
+			if (next_right)
+				next_right->set_parent(old);
+			next->set_parent(parent);
+			if (!parent)
+				_root = next;
+			else if (parent->_left == old)
+				parent->_left = next;
+			else
+				parent->_right = next;
+			swap_colors(old, next);
+		};
+
+		/*
+		** Unlinks old and rebalances, other nodes keep their contents and places in memory.
+		** A sentinel below old moves to the node taking its place at the end of the tree:
+		** the child left by old or else its parent.
+		*/
 		void	RBTDelete(Node<Key, T> *old) {
-			Node<Key, T>	*replace = RBTReplace(old);
-			Node<Key, T>	*parent = old->_parent;
-			bool	blacks = (((!replace) || (replace->_color == BLACK))
-			&& (old->_color == BLACK));
+			Node<Key, T>	*replace;
+			Node<Key, T>	*parent;
+			Node<Key, T>	*leftmost = NULL;
+			Node<Key, T>	*rightmost = NULL;
+			bool			blacks;
 
+			if (!is_nil(old->_left) && !is_nil(old->_right))
+				swapWithSuccessor(old, minimum(old->_right));
+			replace = RBTReplace(old);
+			parent = old->parent();
+			if (_end_left->parent() == old) {
+				leftmost = replace ? replace : parent;
+				old->_left = NULL;
+			}
+			if (_end_right->parent() == old) {
+				rightmost = replace ? replace : parent;
+				old->_right = NULL;
+			}
+			blacks = (((!replace) || (replace->color() == BLACK)) && (old->color() == BLACK));
 			if (!replace) {
 				if (old == _root)
 					_root = NULL;
 				else {
 					if (blacks)
 						fixBlacks(old);
-					else {
-						if (old->sibling())
-							old->sibling()->_color = RED;
-					}
+					else if (!is_nil(old->sibling()))
+						old->sibling()->set_color(RED);
+					if (old->isLeft())
+						old->parent()->_left = NULL;
+					else
+						old->parent()->_right = NULL;
+					update_path(old->parent());
 				}
-				if (old->isLeft())
-					parent->_left = NULL;
+			}
+			else {
+				if (old == _root)
+					_root = replace;
+				else if (old->isLeft())
+					parent->_left = replace;
 				else
-					parent->_right = NULL;
-				delete old;
-				return ;
+					parent->_right = replace;
+				replace->set_parent(parent);
+				if (blacks && (replace != _root))
+					fixBlacks(replace);
+				else
+					replace->set_color(BLACK);
+				update_path(replace->parent());
+			}
+			destroy_node(old);
+			if (leftmost) {
+				leftmost->_left = _end_left;
+				_end_left->set_parent(leftmost);
+			}
+			if (rightmost) {
+				rightmost->_right = _end_right;
+				_end_right->set_parent(rightmost);
+			}
+			if (!_root) {
+				_end_left->set_parent(NULL);
+				_end_right->set_parent(NULL);
+			}
+		};
+
+		/*
+		** Links a detached node as the left or right child of parent (the root if parent is NULL) and rebalances.
+		** Sentinels are the header links of the tree: _end_left hangs below the leftmost node
+		** and _end_right below the rightmost one, a node linked in place of one takes it below.
+		*/
+		Node<Key, T>*	link_node(Node<Key, T> *parent, bool left, Node<Key, T> *node) {
+			Node<Key, T>	*current = node;
+
+			node->set_parent(parent);
+			if (!parent) {
+				_root = node;
+				node->_left = _end_left;
+				node->_right = _end_right;
+				_end_left->set_parent(node);
+				_end_right->set_parent(node);
 			}
-			if ((!old->_left) || (!old->_right)) {
-				if (old == _root) {
-					old->_content = replace->_content;
-					old->_left = NULL;
-					old->_right = NULL;
-					delete replace;
+			else if (left) {
+				if (parent->_left == _end_left) {
+					node->_left = _end_left;
+					_end_left->set_parent(node);
 				}
-				else {
-					if (old->isLeft())
-						parent->_left = replace;
-					else
-						parent->_right = replace;
-					delete old;
-					replace->_parent = parent;
-					if (blacks)
-						fixBlacks(replace);
-					else
-						replace->_color = BLACK;
+				parent->_left = node;
+			}
+			else {
+				if (parent->_right == _end_right) {
+					node->_right = _end_right;
+					_end_right->set_parent(node);
 				}
-				return ;
+				parent->_right = node;
 			}
-			swap_element(old->_content, replace->_content);
-			RBTDelete(replace);
+			update_path(node);
+			fixViolation(_root, current);
+			_size++;
+			return (node);
 		};
 
 	public:
 		Node<Key, T>*	insert(const Key &key, const T &value) {
-			Node<Key, T>	*pt = new Node<Key, T>(key, value);
-			Node<Key, T>	*maxi;
-			Node<Key, T>	*mini;
+			return (RBTInsert(_root, create_node(key, value)));
+		};
 
-			if (_root) {
-				maximum(_root)->_right = NULL;
-				minimum(_root)->_left = NULL;
+		/*
+		** Inserts key with value as insert_unique() does, close to hint (_end_right for the end):
+		** when the key goes right before or right after the hint, the node is linked
+		** there in amortized constant time, otherwise the tree is descended from the root.
+		*/
+		std::pair<Node<Key, T> *, bool>	insert_hint(Node<Key, T> *hint, const Key &key, const T &value) {
+			Node<Key, T>	*neighbour;
+
+			if (!_root || (hint == _end_left))
+				return (insert_unique(key, value));
+			if (hint == _end_right) {
+				if (_compare(_end_right->parent()->_content.first, key))
+					return (std::make_pair(link_node(_end_right->parent(), false, create_node(key, value)), true));
+				return (insert_unique(key, value));
 			}
-			_root = RBTInsert(_root, pt);
-			fixViolation(_root, pt);
-			_size++;
-			maxi = maximum(_root);
-			maxi->_right = _end_right;
-			_end_right->_parent = maxi;
-			mini = minimum(_root);
-			mini->_left = _end_left;
-			_end_left->_parent = mini;
-			return (pt);
+			if (_compare(key, hint->_content.first)) {
+				if (hint == _end_left->parent())
+					return (std::make_pair(link_node(hint, true, create_node(key, value)), true));
+				neighbour = predecessor(hint);
+				if (!_compare(neighbour->_content.first, key))
+					return (insert_unique(key, value));
+				if (is_nil(neighbour->_right))
+					return (std::make_pair(link_node(neighbour, false, create_node(key, value)), true));
+				return (std::make_pair(link_node(hint, true, create_node(key, value)), true));
+			}
+			if (_compare(hint->_content.first, key)) {
+				if (hint == _end_right->parent())
+					return (std::make_pair(link_node(hint, false, create_node(key, value)), true));
+				neighbour = successor(hint);
+				if (!_compare(key, neighbour->_content.first))
+					return (insert_unique(key, value));
+				if (is_nil(hint->_right))
+					return (std::make_pair(link_node(hint, false, create_node(key, value)), true));
+				return (std::make_pair(link_node(neighbour, true, create_node(key, value)), true));
+			}
+			return (std::make_pair(hint, false));
 		};
-		
-		Node<Key, T>*	insert(Node<Key, T> *pos, const Key &key, const T &value) {
-			Node<Key, T>	*pt = new Node<Key, T>(key, value);
-			Node<Key, T>	*maxi;
-			Node<Key, T>	*mini;
 
-			if (_root) {
-				maximum(_root)->_right = NULL;
-				minimum(_root)->_left = NULL;
-			}
-			if (pos == _root)
-				_root = RBTInsert(pos, pt);
-			else
-				RBTInsert(pos, pt);
-			fixViolation(_root, pt);
-			_size++;
-			maxi = maximum(_root);
-			maxi->_right = _end_right;
-			_end_right->_parent = maxi;
-			mini = minimum(_root);
-			mini->_left = _end_left;
-			_end_left->_parent = mini;
-			return (pt);
-		};
-
-		//Searches tree node with given key
-		Node<Key, T>*	search(const Key &key, Compare compare = Compare()) {
-			Node<Key, T>	*tmp = _root;
-
-			while ((tmp) && (tmp != _end_left)
-				&& (tmp != _end_right)) {
-				if (compare(key, tmp->_content.first))
-					tmp = tmp->_left;
-				else if (key == tmp->_content.first)
-					break ;
+		/*
+		** Inserts key with value unless the tree holds an equivalent key.
+		** One descent finds either that key or the parent of the new node,
+		** the node is allocated only when it is linked.
+		** Returns the node holding the key and whether it was inserted.
+		*/
+		std::pair<Node<Key, T> *, bool>	insert_unique(const Key &key, const T &value) {
+			Node<Key, T>	*current = _root;
+			Node<Key, T>	*parent = NULL;
+			bool			left = true;
+
+			while (current && (current != _end_left) && (current != _end_right)) {
+				parent = current;
+				if (_compare(key, current->_content.first)) {
+					left = true;
+					current = current->_left;
+				}
+				else if (_compare(current->_content.first, key)) {
+					left = false;
+					current = current->_right;
+				}
 				else
-					tmp = tmp->_right;
+					return (std::make_pair(current, false));
 			}
-			return (tmp);
+			return (std::make_pair(link_node(parent, left, create_node(key, value)), true));
 		};
-		
-		//Counts tree nodes with given key
-		size_t			count_node(Node<Key, T> *node, const Key &key, Compare compare = Compare()) {
-			size_t			res = 0;
-
-			if ((node) && ((node != _end_left)
-				|| (node != _end_right))) {
-				if (compare(key, node->_content.first))
-					res += count_node(node->_left, key);
-				else if (key == node->_content.first) {
-					res++;
-					res += count_node(node->_left, key);
-					res += count_node(node->_right, key);
+
+		//Searches tree node with given key, NULL if there is none
+		Node<Key, T>*	search(const Key &key) const {
+			Node<Key, T>	*found = lower_bound(key);
+
+			if ((found == _end_right) || _compare(key, found->_content.first))
+				return (NULL);
+			return (found);
+		};
+
+		//Counts tree nodes with given key: keys are unique, so 0 or 1
+		size_t			count(const Key &key) const {
+			return (search(key) ? 1 : 0);
+		};
+
+		/*
+		** Boundaries of the keys equivalent to key, found by one descent from the root:
+		** the lowest node whose key is not less than key (lower_bound)
+		** or greater than key (upper_bound), _end_right if there is none.
+		*/
+		Node<Key, T>*	lower_bound(const Key &key) const {
+			Node<Key, T>	*current = _root;
+			Node<Key, T>	*bound = _end_right;
+
+			while (current && (current != _end_left) && (current != _end_right)) {
+				if (!_compare(current->_content.first, key)) {
+					bound = current;
+					current = current->_left;
 				}
 				else
-					res += count_node(node->_right, key);
+					current = current->_right;
 			}
-			return (res);
+			return (bound);
 		};
 
-		size_t			count(const Key &key, Compare compare = Compare()) {
-			Node<Key, T>	*tmp = _root;
-			size_t			res = 0;
+		Node<Key, T>*	upper_bound(const Key &key) const {
+			Node<Key, T>	*current = _root;
+			Node<Key, T>	*bound = _end_right;
 
-			if ((tmp) && ((tmp != _end_left)
-				|| (tmp != _end_right))) {
-				if (compare(key, tmp->_content.first))
-					res += count_node(tmp->_left, key);
-				else if (key == tmp->_content.first) {
-					res++;
-					res += count_node(tmp->_left, key);
-					res += count_node(tmp->_right, key);
+			while (current && (current != _end_left) && (current != _end_right)) {
+				if (_compare(key, current->_content.first)) {
+					bound = current;
+					current = current->_left;
 				}
 				else
-					res += count_node(tmp->_right, key);
+					current = current->_right;
 			}
-			return (res);
+			return (bound);
 		};
 
-		//Deletes tree node with given key
-		Key				erase(const Key &key) {
-			Key	tmp = '\0';
+		/*
+		** Order statistics, for Augment = order_statistics only, in O(log n):
+		** the number of keys less than key, and the node at position index
+		** in key order, _end_right past the last one.
+		*/
+		size_t			rank(const Key &key) const {
+			return (Augment::template rank<node_type>(lower_bound(key)));
+		};
 
-			if (_root) {
-				Node<Key, T>	*founded = search(key);
-				Node<Key, T>	*maxi;
-				Node<Key, T>	*mini;
+		Node<Key, T>*	select(size_t index) const {
+			if (index >= _size)
+				return (_end_right);
+			return (Augment::template select<node_type>(_root, index));
+		};
 
-				if (founded) {
-					maximum(_root)->_right = NULL;
-					minimum(_root)->_left = NULL;
-					tmp = successor(founded)->_content.first;
-					RBTDelete(founded);
-					_size--;
-					maxi = maximum(_root);
-					maxi->_right = _end_right;
-					_end_right->_parent = maxi;
-					mini = minimum(_root);
-					mini->_left = _end_left;
-					_end_left->_parent = mini;
+		//Summary of the whole tree under the augmentation policy, in O(1)
+		typename Augment::summary_type	aggregate(void) const {
+			return (Augment::template summary<node_type>(_root));
+		};
+
+		/*
+		** Summary of the keys in [lo, hi) under the augmentation policy, in O(log n):
+		** descends to the highest node in the range, then sums the keys not less than lo
+		** in its left subtree and the keys less than hi in its right one, whole subtrees
+		** at a time, combining them in key order.
+		*/
+		typename Augment::summary_type	aggregate(const Key &lo, const Key &hi) const {
+			typename Augment::summary_type	suffix = Augment::identity();
+			typename Augment::summary_type	prefix = Augment::identity();
+			Node<Key, T>					*split = _root;
+			Node<Key, T>					*current;
+
+			while (!is_nil(split)) {
+				if (_compare(split->_content.first, lo))
+					split = split->_right;
+				else if (!_compare(split->_content.first, hi))
+					split = split->_left;
+				else
+					break ;
+			}
+			if (is_nil(split))
+				return (suffix);
+			for (current = split->_left; !is_nil(current); ) {
+				if (_compare(current->_content.first, lo))
+					current = current->_right;
+				else {
+					suffix = Augment::combine(Augment::combine(Augment::template lift<node_type>(current),
+						Augment::template summary<node_type>(current->_right)), suffix);
+					current = current->_left;
+				}
+			}
+			for (current = split->_right; !is_nil(current); ) {
+				if (_compare(current->_content.first, hi)) {
+					prefix = Augment::combine(prefix, Augment::combine(
+						Augment::template summary<node_type>(current->_left), Augment::template lift<node_type>(current)));
+					current = current->_right;
 				}
 				else
-					throw std::out_of_range("Key is out of range");
+					current = current->_left;
+			}
+			return (Augment::combine(Augment::combine(suffix, Augment::template lift<node_type>(split)), prefix));
+		};
+
+		//Augments node again after its value changed in place, and its ancestors: O(log n)
+		void			refresh(Node<Key, T> *node) {
+			update_path(node);
+		};
+
+		//Deletes tree node with given key, returns the number of nodes deleted: 0 or 1
+		size_t			erase(const Key &key) {
+			Node<Key, T>	*found = search(key);
+
+			if (!found)
+				return (0);
+			erase_node(found);
+			return (1);
+		};
+
+		//Unlinks and destroys node, found by the caller: no search, other nodes stay valid
+		void			erase_node(Node<Key, T> *node) {
+			RBTDelete(node);
+			_size--;
+		};
+
+		/*
+		** Deletes the nodes from first up to last excluded, one unlink each:
+		** the successor of a node is taken before the node goes.
+		** The whole tree goes through clear().
+		*/
+		void			erase_range(Node<Key, T> *first, Node<Key, T> *last) {
+			Node<Key, T>	*next;
+
+			if ((first == _end_left->parent()) && (last == _end_right)) {
+				clear();
+				return ;
+			}
+			while (first != last) {
+				next = successor(first);
+				erase_node(first);
+				first = next;
 			}
-			return (tmp);
 		};
 
 		//Finds node in current subtree that does not have a left child
@@ -445,10 +728,10 @@ namespace ft
 			** Else it is the lowest ancestor of current node whose
 			** right child is also an ancestor of current node
 			*/
-			Node<Key, T>	*parent = current->_parent;
+			Node<Key, T>	*parent = current->parent();
 			while (parent && (current == parent->_right)) {
 				current = parent;
-				parent = parent->_parent;
+				parent = parent->parent();
 			}
 			return (parent);
 		};
@@ -466,47 +749,549 @@ namespace ft
 			** Else it is the lowest ancestor of current node whose
 			** left child is also an ancestor of current node
 			*/
-			Node<Key, T>	*parent = current->_parent;
+			Node<Key, T>	*parent = current->parent();
 			while (parent && (current == parent->_left)) {
 				current = parent;
-				parent = parent->_parent;
+				parent = parent->parent();
 			}
 			return (parent);
 		};
 
 		//To perform clear of tree as a whole you need to set _root as a node
 		void			clear(void) {
-			if (_root) {
-				maximum(_root)->_right = NULL;
-				minimum(_root)->_left = NULL;
-			}
 			clear_nodes(_root);
 			_root = NULL;
-			_end_right->_parent = NULL;
-			_end_left->_parent = NULL;
+			_end_right->set_parent(NULL);
+			_end_left->set_parent(NULL);
 		};
 		
-		//Performing tree nodes clearing one by one
+		/*
+		** Performing tree nodes clearing one by one, without recursion nor stack:
+		** a left child is rotated up until the node has none, then the node is destroyed
+		** and clearing goes on with its right subtree
+		*/
 		void			clear_nodes(Node<Key, T> *root) {
-			if (!root)
+			Node<Key, T>	*left;
+			Node<Key, T>	*right;
+
+			while (!is_nil(root)) {
+				if (!is_nil(root->_left)) {
+					left = root->_left;
+					root->_left = left->_right;
+					left->_right = root;
+					root = left;
+				}
+				else {
+					right = root->_right;
+					destroy_node(root);
+					_size--;
+					root = right;
+				}
+			}
+		};
+
+		/*
+		** Structural copy of other into this empty tree, in O(n) and without comparisons:
+		** every node is cloned with its color at the same place, walking both trees in step
+		** down the child links and up the parent links. The sentinels go below the clones
+		** of the extreme nodes of other. If a copy throws, the clones made so far are destroyed.
+		*/
+		void			clone(const RBTree &other) {
+			Node<Key, T>	*source = other._root;
+			Node<Key, T>	*root;
+			Node<Key, T>	*target;
+			Node<Key, T>	*leftmost;
+			Node<Key, T>	*rightmost;
+
+			if (!source)
 				return ;
+			root = clone_node(source, NULL);
+			target = root;
+			leftmost = root;
+			rightmost = root;
+			try {
+				while (true) {
+					if (!other.is_nil(source->_left) && !target->_left) {
+						source = source->_left;
+						target->_left = clone_node(source, target);
+						target = target->_left;
+					}
+					else if (!other.is_nil(source->_right) && !target->_right) {
+						source = source->_right;
+						target->_right = clone_node(source, target);
+						target = target->_right;
+					}
+					else if (source == other._root)
+						break ;
+					else {
+						source = source->parent();
+						target = target->parent();
+						continue ;
+					}
+					if (source == other._end_left->parent())
+						leftmost = target;
+					if (source == other._end_right->parent())
+						rightmost = target;
+				}
+			}
+			catch (...) {
+				clear_nodes(root);
+				_size = 0;
+				throw ;
+			}
+			_root = root;
+			_size = other._size;
+			leftmost->_left = _end_left;
+			_end_left->set_parent(leftmost);
+			rightmost->_right = _end_right;
+			_end_right->set_parent(rightmost);
+		};
 
-			//Performing recursive deleting of both subtrees at first
-			clear_nodes(root->_left);
-			clear_nodes(root->_right);
-			
-			//Deleting the current node
-			delete root;
-			_size--;
+		//Detached copy of source with its color and augmentation, below parent
+		Node<Key, T>*	clone_node(Node<Key, T> *source, Node<Key, T> *parent) {
+			Node<Key, T>	*node = create_node(*static_cast<node_type *>(source));
+
+			node->_left = NULL;
+			node->_right = NULL;
+			node->set_parent(parent);
+			return (node);
+		};
+
+		/*
+		** Bulk load of this empty tree: takes elements from first on while their keys
+		** strictly increase and builds a perfectly balanced tree of them in O(n).
+		** Returns the first element not taken, which breaks the order, or last.
+		** If a copy or an iterator throws, the nodes made so far are destroyed.
+		*/
+		template <class InputIt>
+		InputIt			build_sorted(InputIt first, InputIt last) {
+			Node<Key, T>	*chain = NULL;
+			Node<Key, T>	*tail = NULL;
+			Node<Key, T>	*node;
+			size_t			count = 0;
+			size_t			red_depth = 0;
+
+			if (_root)
+				return (first);
+			try {
+				for (; first != last; ++first) {
+					if (tail && !_compare(tail->_content.first, (*first).first))
+						break ;
+					node = create_node((*first).first, (*first).second);
+					if (tail)
+						tail->_right = node;
+					else
+						chain = node;
+					tail = node;
+					count++;
+				}
+			}
+			catch (...) {
+				while (chain) {
+					node = chain->_right;
+					destroy_node(chain);
+					chain = node;
+				}
+				throw ;
+			}
+			if (!count)
+				return (first);
+			while ((static_cast<size_t>(2) << red_depth) <= count)
+				red_depth++;
+			node = chain;
+			_root = build_balanced(chain, count, 0, red_depth);
+			_root->set_parent(NULL);
+			_size = count;
+			node->_left = _end_left;
+			_end_left->set_parent(node);
+			tail->_right = _end_right;
+			_end_right->set_parent(tail);
+			return (first);
+		};
+
+		/*
+		** Moves the nodes with keys not less than key into right, which must be empty
+		** and have an allocator equal to this one: nodes are relinked, never copied.
+		** Relinking takes O(log n). Sizes are read from order_statistics subtree sizes,
+		** otherwise the smaller part is counted.
+		*/
+		void			split(const Key &key, RBTree &right) {
+			subtree			low;
+			subtree			high;
+			Node<Key, T>	*found;
+			size_t			total = _size;
+			size_t			low_size;
+
+			if (!_root || (&right == this))
+				return ;
+			split_subtree(strip(), key, low, found, high);
+			if (found)
+				high = join_subtrees(subtree(), found, high);
+			low_size = part_size(low.root, high.root, total, static_cast<Augment *>(NULL));
+			adopt(low, low_size);
+			right.adopt(high, total - low_size);
+		};
+
+		/*
+		** Appends the nodes of right, whose keys are all greater than the ones of this tree,
+		** in O(log n). right is left empty, its allocator must be equal to this one.
+		*/
+		void			join(RBTree &right) {
+			size_t	size = _size + right._size;
+			subtree	low;
+
+			if (&right == this)
+				return ;
+			low = strip();
+			adopt(concat_subtrees(low, right.strip()), size);
+			right._size = 0;
+		};
+
+		/*
+		** Moves into this tree the nodes of other with keys it does not hold, the others stay
+		** in other. O(m log(n / m + 1)) for sizes m <= n: the smaller tree is taken apart root
+		** by root and the larger one split at their keys. Allocators must be equal.
+		*/
+		void			merge_unique(RBTree &other) {
+			size_t	total = _size + other._size;
+			size_t	duplicates = 0;
+			subtree	mine;
+			subtree	theirs;
+			subtree	kept;
+			subtree	merged;
+
+			if ((&other == this) || !other._root)
+				return ;
+			mine = strip();
+			theirs = other.strip();
+			if (_size <= other._size)
+				merged = unite_subtrees(mine, theirs, true, kept, duplicates);
+			else
+				merged = unite_subtrees(theirs, mine, false, kept, duplicates);
+			adopt(merged, total - duplicates);
+			other.adopt(kept, duplicates);
+		};
+
+		/*
+		** Destroys the nodes whose keys other does not hold (intersect) or holds (subtract).
+		** other is only read: this tree is split at the keys of other, down from its root,
+		** as long as the part left between them is not empty, in O(m log(n / m + 1)),
+		** plus the destruction of the nodes dropped.
+		*/
+		void			intersect(const RBTree &other) {
+			size_t	kept = 0;
+			subtree	tree;
+
+			if (&other == this)
+				return ;
+			tree = intersect_subtrees(strip(), other, other._root, kept);
+			adopt(tree, kept);
+		};
+
+		void			subtract(const RBTree &other) {
+			size_t	size = _size;
+			size_t	dropped = 0;
+			subtree	tree;
+
+			if (&other == this) {
+				clear();
+				return ;
+			}
+			tree = subtract_subtrees(strip(), other, other._root, dropped);
+			adopt(tree, size - dropped);
+		};
+
+	private:
+		/*
+		** Links the next count nodes of chain (in order, through _right) into a subtree
+		** whose halves differ by one node at most: its leaves lie on two levels only,
+		** coloring red the nodes of the deepest level possible keeps every black height equal
+		*/
+		Node<Key, T>*	build_balanced(Node<Key, T> *&chain, size_t count, size_t depth, size_t red_depth) {
+			Node<Key, T>	*left;
+			Node<Key, T>	*node;
+
+			if (!count)
+				return (NULL);
+			left = build_balanced(chain, (count - 1) / 2, depth + 1, red_depth);
+			node = chain;
+			chain = chain->_right;
+			node->_left = left;
+			if (left)
+				left->set_parent(node);
+			node->set_color((depth && (depth == red_depth)) ? RED : BLACK);
+			node->_right = build_balanced(chain, count - 1 - (count - 1) / 2, depth + 1, red_depth);
+			if (node->_right)
+				node->_right->set_parent(node);
+			update(node);
+			return (node);
+		};
+
+		//Detached red-black tree: a root without parent nor sentinels, NULL if empty, and its black height
+		struct subtree {
+			Node<Key, T>	*root;
+			int				height;
+
+			subtree(Node<Key, T> *tree_root = NULL, int tree_height = 0) : root(tree_root), height(tree_height) {};
+		};
+
+		//Takes the nodes out of this tree, left empty but for its size, as a detached tree
+		subtree			strip(void) {
+			subtree			tree(_root, 0);
+			Node<Key, T>	*node;
+
+			if (!_root)
+				return (tree);
+			_end_left->parent()->_left = NULL;
+			_end_right->parent()->_right = NULL;
+			_end_left->set_parent(NULL);
+			_end_right->set_parent(NULL);
+			for (node = _root; node; node = node->_left)
+				if (node->color() == BLACK)
+					tree.height++;
+			_root = NULL;
+			return (tree);
+		};
+
+		//Makes a detached tree of size nodes the content of this empty tree: sentinels go below its extreme nodes
+		void			adopt(const subtree &tree, size_t size) {
+			Node<Key, T>	*extreme;
+
+			_root = tree.root;
+			_size = size;
+			if (!_root)
+				return ;
+			for (extreme = _root; extreme->_left; extreme = extreme->_left) ;
+			extreme->_left = _end_left;
+			_end_left->set_parent(extreme);
+			for (extreme = _root; extreme->_right; extreme = extreme->_right) ;
+			extreme->_right = _end_right;
+			_end_right->set_parent(extreme);
+		};
+
+		//Detaches node, a child of a black node of black height height + 1, as a tree: a red root turns black
+		subtree			detach(Node<Key, T> *node, int height) {
+			if (!node)
+				return (subtree());
+			node->set_parent(NULL);
+			if (node->color() == RED) {
+				node->set_color(BLACK);
+				height++;
+			}
+			return (subtree(node, height));
+		};
+
+		/*
+		** Links middle between left and right, whose keys are less and greater than its own:
+		** middle goes red down the inner spine of the higher tree, to the first black node
+		** as high as the lower tree, then the insertion fix-up restores the red rule.
+		** O(difference of black heights).
+		*/
+		subtree			join_subtrees(const subtree &left, Node<Key, T> *middle, const subtree &right) {
+			Node<Key, T>	*parent = NULL;
+			Node<Key, T>	*current;
+			Node<Key, T>	*root;
+			int				height;
+
+			if (left.height == right.height) {
+				middle->_left = left.root;
+				middle->_right = right.root;
+				middle->set_parent(NULL);
+				middle->set_color(BLACK);
+			}
+			else if (left.height > right.height) {
+				for (current = left.root, height = left.height;
+					(height > right.height) || (current && (current->color() == RED)); current = current->_right) {
+					if (current->color() == BLACK)
+						height--;
+					parent = current;
+				}
+				middle->_left = current;
+				middle->_right = right.root;
+				parent->_right = middle;
+			}
+			else {
+				for (current = right.root, height = right.height;
+					(height > left.height) || (current && (current->color() == RED)); current = current->_left) {
+					if (current->color() == BLACK)
+						height--;
+					parent = current;
+				}
+				middle->_left = left.root;
+				middle->_right = current;
+				parent->_left = middle;
+			}
+			if (middle->_left)
+				middle->_left->set_parent(middle);
+			if (middle->_right)
+				middle->_right->set_parent(middle);
+			if (!parent) {
+				update(middle);
+				return (subtree(middle, left.height + 1));
+			}
+			middle->set_parent(parent);
+			middle->set_color(RED);
+			update_path(middle);
+			root = (left.height > right.height) ? left.root : right.root;
+			height = (left.height > right.height) ? left.height : right.height;
+			if (fixViolation(root, middle))
+				height++;
+			return (subtree(root, height));
+		};
+
+		//Joins left and right, whose keys are all less than the ones of right, taking the last node of left as middle
+		subtree			concat_subtrees(const subtree &left, const subtree &right) {
+			subtree			rest;
+			Node<Key, T>	*last;
+
+			if (!left.root)
+				return (right);
+			if (!right.root)
+				return (left);
+			last = split_last(left, rest);
+			return (join_subtrees(rest, last, right));
 		};
 
-		//Copy for a tree
-		void			copy(Node<Key, T> *root) {
-			if (!root)
+		//Takes the last node out of a non-empty tree, the other nodes go to rest
+		Node<Key, T>*	split_last(const subtree &tree, subtree &rest) {
+			Node<Key, T>	*node = tree.root;
+			Node<Key, T>	*last;
+			subtree			left = detach(node->_left, tree.height - 1);
+			subtree			right = detach(node->_right, tree.height - 1);
+
+			if (!right.root) {
+				rest = left;
+				return (node);
+			}
+			last = split_last(right, rest);
+			rest = join_subtrees(left, node, rest);
+			return (last);
+		};
+
+		/*
+		** Splits tree into the nodes with keys less than key (low) and greater (high), found
+		** gets the node with key or NULL. The search path is taken apart and the subtrees
+		** hanging from it joined back on either side: the joins cost O(log n) all together.
+		*/
+		void			split_subtree(const subtree &tree, const Key &key, subtree &low, Node<Key, T> *&found, subtree &high) {
+			Node<Key, T>	*node = tree.root;
+			subtree			left;
+			subtree			right;
+			subtree			part;
+
+			found = NULL;
+			if (!node) {
+				low = subtree();
+				high = subtree();
 				return ;
-			insert(root->_content.first, root->_content.second);
-			copy(root->_left);
-			copy(root->_right);
+			}
+			left = detach(node->_left, tree.height - 1);
+			right = detach(node->_right, tree.height - 1);
+			if (_compare(key, node->_content.first)) {
+				split_subtree(left, key, low, found, part);
+				high = join_subtrees(part, node, right);
+			}
+			else if (_compare(node->_content.first, key)) {
+				split_subtree(right, key, part, found, high);
+				low = join_subtrees(left, node, part);
+			}
+			else {
+				low = left;
+				found = node;
+				high = right;
+			}
+		};
+
+		/*
+		** Union of the detached trees a and b, split at the root of a. The nodes of equal keys
+		** go to duplicates: the ones of b, or of a if a_wins is false; count gets their number.
+		*/
+		subtree			unite_subtrees(const subtree &a, const subtree &b, bool a_wins, subtree &duplicates, size_t &count) {
+			Node<Key, T>	*kept = a.root;
+			Node<Key, T>	*dropped;
+			subtree			left;
+			subtree			right;
+			subtree			low;
+			subtree			high;
+			subtree			left_duplicates;
+			subtree			right_duplicates;
+
+			duplicates = subtree();
+			if (!a.root || !b.root)
+				return (a.root ? a : b);
+			left = detach(kept->_left, a.height - 1);
+			right = detach(kept->_right, a.height - 1);
+			split_subtree(b, kept->_content.first, low, dropped, high);
+			left = unite_subtrees(left, low, a_wins, left_duplicates, count);
+			right = unite_subtrees(right, high, a_wins, right_duplicates, count);
+			if (!dropped)
+				duplicates = concat_subtrees(left_duplicates, right_duplicates);
+			else {
+				if (!a_wins)
+					swap_element(kept, dropped);
+				duplicates = join_subtrees(left_duplicates, dropped, right_duplicates);
+				count++;
+			}
+			return (join_subtrees(left, kept, right));
+		};
+
+		//Keeps the nodes of tree with keys in the subtree of node in other, count gets their number
+		subtree			intersect_subtrees(const subtree &tree, const RBTree &other, Node<Key, T> *node, size_t &count) {
+			subtree			low;
+			subtree			high;
+			Node<Key, T>	*found;
+
+			if (!tree.root)
+				return (tree);
+			if (other.is_nil(node)) {
+				clear_nodes(tree.root);
+				return (subtree());
+			}
+			split_subtree(tree, node->_content.first, low, found, high);
+			low = intersect_subtrees(low, other, node->_left, count);
+			high = intersect_subtrees(high, other, node->_right, count);
+			if (!found)
+				return (concat_subtrees(low, high));
+			count++;
+			return (join_subtrees(low, found, high));
+		};
+
+		//Destroys the nodes of tree with keys in the subtree of node in other, count gets their number
+		subtree			subtract_subtrees(const subtree &tree, const RBTree &other, Node<Key, T> *node, size_t &count) {
+			subtree			low;
+			subtree			high;
+			Node<Key, T>	*found;
+
+			if (!tree.root || other.is_nil(node))
+				return (tree);
+			split_subtree(tree, node->_content.first, low, found, high);
+			low = subtract_subtrees(low, other, node->_left, count);
+			high = subtract_subtrees(high, other, node->_right, count);
+			if (found) {
+				destroy_node(found);
+				count++;
+			}
+			return (concat_subtrees(low, high));
+		};
+
+		//Size of first, the first of two detached trees of total nodes: read from the subtree sizes
+		size_t			part_size(Node<Key, T> *first, Node<Key, T> *, size_t, order_statistics *) const {
+			return (order_statistics::size<node_type>(first));
+		};
+
+		//Otherwise both trees are walked in step, until the smaller one ends
+		template < class Policy >
+		size_t			part_size(Node<Key, T> *first, Node<Key, T> *second, size_t total, Policy *) const {
+			size_t	steps = 0;
+
+			first = first ? first->minimum(first) : NULL;
+			second = second ? second->minimum(second) : NULL;
+			while (first && second) {
+				first = first->successor(first);
+				second = second->successor(second);
+				steps++;
+			}
+			return (first ? total - steps : steps);
 		};
 	};
 };
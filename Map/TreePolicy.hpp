@@ -0,0 +1,249 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TreePolicy.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mskinner <v.golskiy@ya.ru>                 +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/06/24 11:02:37 by mskinner          #+#    #+#             */
+/*   Updated: 2021/06/24 11:02:37 by mskinner         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Augmentation policies of the red-black tree, last template parameter of ft::RBTree
+** and ft::map. A policy chooses the node type and recomputes what a node keeps about
+** its subtree from its children: the tree calls update() on both nodes of a rotation
+** and on the path up from a node linked or unlinked, so the data stays exact.
+** + plain_tree, the default, keeps nothing: its nodes and iterators are the ones
+** of an unaugmented map and every update() call compiles away,
+** + monoid_summary<Monoid> keeps the summary of every subtree under an associative
+** combine: aggregate() over a key range takes O(log n),
+** + order_statistics is the summary of element counts, with rank, select
+** and iterator distance in O(log n);
+** - an augmented node carries a summary more, and every insertion or deletion walks up to the root.
+**
+** ft::map<int, int, std::less<int>, std::allocator<std::pair<const int, int> >,
+**	ft::order_statistics>	latencies;
+*/
+
+#pragma once
+
+#ifndef _TREE_POLICY_HPP_
+# define _TREE_POLICY_HPP_
+
+# include "Node.hpp"
+
+namespace ft
+{
+	//Tree node carrying Data about its subtree, sentinels keep a value-initialized Data
+	template < typename Key, typename T, typename Data >
+	class AugmentedNode : public Node<Key, T>
+	{
+	public:
+		typedef Node<Key, T>	base_type;
+		typedef Data			data_type;
+
+		Data	_data;
+
+		AugmentedNode() : base_type(), _data() {};
+		AugmentedNode(const Key &key, const T &content) : base_type(key, content), _data() {};
+		AugmentedNode(const AugmentedNode &copy) : base_type(copy), _data(copy._data) {};
+		~AugmentedNode() {};
+		AugmentedNode&	operator=(const AugmentedNode &other) {
+			if (this != &other) {
+				base_type::operator=(other);
+				_data = other._data;
+			}
+			return (*this);
+		};
+	};
+
+	/*
+	** Iterator of an order statistics map: Base (the plain iterator) with the distance
+	** between two iterators of the same map computed from the ranks of their nodes
+	*/
+	template < class Base, class NodeType >
+	class RankedIterator : public Base
+	{
+	public:
+		typedef typename Base::difference_type	difference_type;
+
+		//Coplien form
+		RankedIterator(void) : Base() {};
+		explicit RankedIterator(typename NodeType::base_type *root) : Base(root) {};
+		RankedIterator(const Base &base) : Base(base) {};
+		RankedIterator(const RankedIterator &copy) : Base(copy) {};
+		virtual ~RankedIterator() {};
+		RankedIterator&	operator=(const RankedIterator &other) {
+			Base::operator=(other);
+			return (*this);
+		};
+
+		//Number of increments from other to this iterator, in O(log n)
+		difference_type	operator-(const RankedIterator &other) const;
+	};
+
+	//No augmentation: Node as it is, nothing to update
+	struct plain_tree
+	{
+		static const bool	augmented = false;
+		typedef void		summary_type;
+
+		template < typename Key, typename T >
+		struct node {
+			typedef Node<Key, T>	type;
+		};
+
+		template < class Base, class NodeType >
+		struct iterator {
+			typedef Base	type;
+		};
+
+		template < class NodeType >
+		static void		update(NodeType *) {};
+
+		template < class NodeType >
+		static void		clear(NodeType *) {};
+	};
+
+	/*
+	** Summaries of the subtrees under a monoid supplied by the user:
+	**	typedef S	summary_type;
+	**	static S	identity(void);							summary of no element
+	**	static S	lift(const Key &key, const T &value);	summary of one element
+	**	static S	combine(const S &left, const S &right);	associative, left keys before right ones
+	** A node keeps combine(left subtree, itself, right subtree), sentinels keep identity().
+	** A value changed in place, through operator[] or an iterator, is lifted again by map::refresh().
+	*/
+	template < class Monoid >
+	struct monoid_summary
+	{
+		static const bool						augmented = true;
+		typedef typename Monoid::summary_type	summary_type;
+
+		template < typename Key, typename T >
+		struct node {
+			typedef AugmentedNode<Key, T, summary_type>	type;
+		};
+
+		template < class Base, class NodeType >
+		struct iterator {
+			typedef Base	type;
+		};
+
+		static summary_type	identity(void) {
+			return (Monoid::identity());
+		};
+
+		static summary_type	combine(const summary_type &left, const summary_type &right) {
+			return (Monoid::combine(left, right));
+		};
+
+		//Summary of the subtree of node, identity() for a missing child
+		template < class NodeType >
+		static summary_type	summary(const typename NodeType::base_type *node) {
+			return (node ? static_cast<const NodeType *>(node)->_data : Monoid::identity());
+		};
+
+		//Summary of the element of node alone
+		template < class NodeType >
+		static summary_type	lift(const typename NodeType::base_type *node) {
+			return (Monoid::lift(node->_content.first, node->_content.second));
+		};
+
+		template < class NodeType >
+		static void		update(NodeType *node) {
+			node->_data = Monoid::combine(Monoid::combine(summary<NodeType>(node->_left),
+				lift<NodeType>(node)), summary<NodeType>(node->_right));
+		};
+
+		//Sentinels stand for empty subtrees
+		template < class NodeType >
+		static void		clear(NodeType *node) {
+			node->_data = Monoid::identity();
+		};
+	};
+
+	//Monoid of the number of elements
+	struct element_count
+	{
+		typedef std::size_t	summary_type;
+
+		static std::size_t	identity(void) {
+			return (0);
+		};
+
+		template < typename Key, typename T >
+		static std::size_t	lift(const Key &, const T &) {
+			return (1);
+		};
+
+		static std::size_t	combine(std::size_t left, std::size_t right) {
+			return (left + right);
+		};
+	};
+
+	/*
+	** Subtree sizes: a node counts itself and the nodes below it, sentinels count for nothing.
+	** aggregate() over a key range is the number of elements in it.
+	*/
+	struct order_statistics : public monoid_summary<element_count>
+	{
+		template < class Base, class NodeType >
+		struct iterator {
+			typedef RankedIterator<Base, NodeType>	type;
+		};
+
+		template < class NodeType >
+		static std::size_t	size(const typename NodeType::base_type *node) {
+			return (node ? static_cast<const NodeType *>(node)->_data : 0);
+		};
+
+		template < class NodeType >
+		static void		update(NodeType *node) {
+			node->_data = 1 + size<NodeType>(node->_left) + size<NodeType>(node->_right);
+		};
+
+		/*
+		** Number of nodes before node in key order: its left subtree, then for every step up
+		** from a right child the parent and its left subtree. The right sentinel ranks as the size.
+		*/
+		template < class NodeType >
+		static std::size_t	rank(const typename NodeType::base_type *node) {
+			std::size_t	before = size<NodeType>(node->_left);
+
+			for (; node->parent(); node = node->parent())
+				if (node == node->parent()->_right)
+					before += size<NodeType>(node->parent()->_left) + 1;
+			return (before);
+		};
+
+		//Node at position index in key order below root, index must be less than the size of root
+		template < class NodeType >
+		static typename NodeType::base_type*	select(typename NodeType::base_type *root, std::size_t index) {
+			std::size_t	left;
+
+			while (true) {
+				left = size<NodeType>(root->_left);
+				if (index == left)
+					return (root);
+				if (index < left)
+					root = root->_left;
+				else {
+					index -= left + 1;
+					root = root->_right;
+				}
+			}
+		};
+	};
+
+	template < class Base, class NodeType >
+	typename RankedIterator<Base, NodeType>::difference_type
+		RankedIterator<Base, NodeType>::operator-(const RankedIterator &other) const {
+		return (static_cast<difference_type>(order_statistics::rank<NodeType>(this->get_root()))
+			- static_cast<difference_type>(order_statistics::rank<NodeType>(other.get_root())));
+	};
+};
+
+#endif
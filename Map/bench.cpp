@@ -0,0 +1,294 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench.cpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mskinner <v.golskiy@ya.ru>                 +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/06/28 10:12:44 by mskinner          #+#    #+#             */
+/*   Updated: 2021/06/28 10:12:44 by mskinner         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+//clang++ -Wall -Werror -Wextra --std=c++98 -O2 bench.cpp
+//Timings of ft::map, kept out of main.cpp so that the tests print the same output on every run
+
+#include "Map.hpp"
+#include <vector>
+
+//Sum of the values of a range of keys
+struct Volume {
+	typedef long	summary_type;
+
+	static long	identity(void) {
+		return (0);
+	};
+
+	static long	lift(const int &, const int &value) {
+		return (value);
+	};
+
+	static long	combine(long left, long right) {
+		return (left + right);
+	};
+};
+
+int	main() {
+	typedef ft::map<int, int, std::less<int>, std::allocator<std::pair<const int, int> >, ft::order_statistics>	ranked_map;
+	typedef std::allocator<std::pair<const int, int> >										int_allocator;
+	typedef ft::map<int, int, std::less<int>, int_allocator, ft::monoid_summary<Volume> >	volume_map;
+
+	std::cout << "MAP RANGE QUERY BENCHMARK (1000000 KEYS, 1000000 QUERIES) >>>" << std::endl;
+	ft::map<int, int>	timeline;
+	clock_t				bstart;
+	double				btime;
+	long				checksum = 0;
+	for (int i = 0; i < 1000000; i++)
+		timeline[i * 2] = i;
+	bstart = clock();
+	for (int i = 0; i < 1000000; i++) {
+		int							key = static_cast<int>((i * 7919L) % 2000000);
+		ft::map<int, int>::iterator	from = timeline.lower_bound(key);
+		ft::map<int, int>::iterator	to = timeline.upper_bound(key + 64);
+		if (from != timeline.end())
+			checksum += from->second;
+		if (to != timeline.end())
+			checksum -= to->second;
+	}
+	btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+	std::cout << "lower_bound + upper_bound: " << btime << " ms, checksum " << checksum << std::endl;
+
+	std::cout << std::endl << "MAP UPSERT BENCHMARK (1000000 UPSERTS OVER 100000 KEYS) >>>" << std::endl;
+	ft::map<int, int>	counters;
+	bstart = clock();
+	for (int i = 0; i < 1000000; i++)
+		counters[static_cast<int>((i * 7919L) % 100000)]++;
+	btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+	std::cout << "operator[]: " << btime << " ms, size " << counters.size() << ", counters[0] " << counters[0] << std::endl;
+
+	std::cout << std::endl << "MAP INSERT/ERASE BENCHMARK (1000000 KEYS) >>>" << std::endl;
+	ft::map<int, int>	churn;
+	bstart = clock();
+	for (int i = 0; i < 1000000; i++)
+		churn.insert(std::make_pair(static_cast<int>((i * 7919L) % 1000000), i));
+	btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+	std::cout << "insert: " << btime << " ms";
+	bstart = clock();
+	for (int i = 0; i < 1000000; i++)
+		churn.erase(static_cast<int>((i * 104729L) % 1000000));
+	btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+	std::cout << ", erase: " << btime << " ms, size " << churn.size() << std::endl;
+
+	std::cout << std::endl << "MAP INSERT/ERASE-HEAVY BENCHMARK (2000000 KEYS THROUGH A 1000 KEYS WINDOW) >>>" << std::endl;
+	ft::map<int, int>	window;
+	bstart = clock();
+	for (int i = 0; i < 2000000; i++) {
+		window[i] = i;
+		if (i >= 1000)
+			window.erase(i - 1000);
+	}
+	btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+	std::cout << "sliding window: " << btime << " ms, size " << window.size();
+	ft::RBTree<int, int>	*chain = new ft::RBTree<int, int>();
+	for (int i = 0; i < 1000000; i++)
+		chain->insert(i, i);
+	bstart = clock();
+	{
+		ft::RBTree<int, int>	copied(*chain);
+
+		delete chain;
+	}
+	btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+	std::cout << ", copy and destruction of 1000000 nodes: " << btime << " ms" << std::endl;
+
+	std::cout << std::endl << "MAP CLONE BENCHMARK (1000000 KEYS) >>>" << std::endl;
+	ft::map<int, int>	snapshot_source;
+	for (int i = 0; i < 1000000; i++)
+		snapshot_source[static_cast<int>((i * 7919L) % 1000000)] = i;
+	bstart = clock();
+	{
+		ft::map<int, int>	snapshot(snapshot_source);
+
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << "copy constructor: " << btime << " ms, size " << snapshot.size();
+		bstart = clock();
+		snapshot = snapshot_source;
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << ", assignment: " << btime << " ms" << std::endl;
+	}
+
+	std::cout << std::endl << "MAP SORTED BUILD BENCHMARK (1000000 SORTED PAIRS) >>>" << std::endl;
+	{
+		std::vector<std::pair<int, int> >	loaded;
+
+		for (int i = 0; i < 1000000; i++)
+			loaded.push_back(std::make_pair(i, i));
+		bstart = clock();
+		ft::map<int, int>					index(loaded.begin(), loaded.end());
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << "range constructor: " << btime << " ms, size " << index.size();
+		std::swap(loaded[0], loaded[1]);
+		bstart = clock();
+		ft::map<int, int>					shuffled(loaded.begin(), loaded.end());
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << ", with the first two swapped: " << btime << " ms, size " << shuffled.size() << std::endl;
+	}
+
+	std::cout << std::endl << "MAP HINTED APPEND BENCHMARK (1000000 INCREASING KEYS) >>>" << std::endl;
+	{
+		ft::map<int, int>			appended;
+		ft::map<int, int>			followed;
+		ft::map<int, int>::iterator	last = followed.end();
+
+		bstart = clock();
+		for (int i = 0; i < 1000000; i++)
+			appended.insert(appended.end(), std::make_pair(i, i));
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << "end() as hint: " << btime << " ms";
+		bstart = clock();
+		for (int i = 0; i < 1000000; i++)
+			last = followed.insert(last, std::make_pair(i, i));
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << ", last insertion as hint: " << btime << " ms, sizes " << appended.size() << " " << followed.size() << std::endl;
+	}
+
+	std::cout << std::endl << "MAP WINDOW EXPIRY BENCHMARK (10000 TICKS OF 100 KEYS, 5000 KEYS KEPT) >>>" << std::endl;
+	{
+		ft::map<int, int>	ticks;
+
+		bstart = clock();
+		for (int tick = 0; tick < 10000; tick++) {
+			for (int i = 0; i < 100; i++)
+				ticks.insert(ticks.end(), std::make_pair(tick * 100 + i, i));
+			ticks.erase(ticks.begin(), ticks.lower_bound(tick * 100 - 5000));
+		}
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << "range erase per tick: " << btime << " ms, size " << ticks.size() << std::endl;
+	}
+
+	std::cout << std::endl << "MAP ORDER STATISTICS BENCHMARK (1000000 KEYS) >>>" << std::endl;
+	{
+		ft::map<int, int>	plain;
+		ranked_map			ranked;
+		long				checksum = 0;
+
+		bstart = clock();
+		for (int i = 0; i < 1000000; i++)
+			plain.insert(std::make_pair(static_cast<int>((i * 7919L) % 1000000), i));
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << "insert: " << btime << " ms plain";
+		bstart = clock();
+		for (int i = 0; i < 1000000; i++)
+			ranked.insert(std::make_pair(static_cast<int>((i * 7919L) % 1000000), i));
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << ", " << btime << " ms with subtree sizes" << std::endl;
+		bstart = clock();
+		for (int i = 0; i < 1000000; i++)
+			checksum += ranked.rank(static_cast<int>((i * 104729L) % 1000000));
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << "1000000 rank(): " << btime << " ms";
+		bstart = clock();
+		for (int i = 0; i < 1000000; i++)
+			checksum += ranked.nth(static_cast<std::size_t>((i * 104729L) % 1000000))->first;
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << ", 1000000 nth(): " << btime << " ms";
+		bstart = clock();
+		for (int i = 0; i < 10; i++) {
+			ft::map<int, int>::iterator	walk = plain.begin();
+
+			for (std::size_t step = 0; step < plain.size() * 99 / 100; step++)
+				++walk;
+			checksum += walk->first;
+		}
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << ", 10 99th percentiles by walking: " << btime << " ms, checksum " << checksum << std::endl;
+	}
+
+	std::cout << std::endl << "MAP AGGREGATE BENCHMARK (1000000 KEYS, WINDOWS OF 10000 KEYS) >>>" << std::endl;
+	{
+		volume_map	volumes;
+		long		checksum = 0;
+
+		bstart = clock();
+		for (int i = 0; i < 1000000; i++)
+			volumes.insert(std::make_pair(static_cast<int>((i * 7919L) % 1000000), i % 1000));
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << "insert with range sums: " << btime << " ms";
+		bstart = clock();
+		for (int i = 0; i < 1000000; i++) {
+			int	lo = static_cast<int>((i * 104729L) % 990000);
+
+			checksum += volumes.aggregate(lo, lo + 10000);
+		}
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << ", 1000000 aggregate(): " << btime << " ms";
+		bstart = clock();
+		for (int i = 0; i < 1000; i++) {
+			int							lo = static_cast<int>((i * 104729L) % 990000);
+			volume_map::iterator		it = volumes.lower_bound(lo);
+
+			for (; (it != volumes.end()) && (it->first < lo + 10000); it++)
+				checksum += it->second;
+		}
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << ", 1000 windows iterated: " << btime << " ms, checksum " << checksum << std::endl;
+	}
+
+	std::cout << std::endl << "MAP SPLIT/JOIN AND SET OPERATIONS BENCHMARK (SHARDS OF 1000000 KEYS) >>>" << std::endl;
+	{
+		ft::map<int, int>	low;
+		ft::map<int, int>	high;
+		ft::map<int, int>	evens;
+		ft::map<int, int>	odds;
+		ft::map<int, int>	copied;
+		ranked_map			ranked;
+		ranked_map			ranked_right;
+
+		for (int i = 0; i < 1000000; i++) {
+			low.insert(low.end(), std::make_pair(i, i));
+			high.insert(high.end(), std::make_pair(i + 1000000, i));
+			evens.insert(evens.end(), std::make_pair(i * 2, i));
+			odds.insert(odds.end(), std::make_pair(i * 2 + 1, i));
+			ranked.insert(ranked.end(), std::make_pair(i, i));
+		}
+		copied = low;
+		bstart = clock();
+		for (ft::map<int, int>::iterator it = high.begin(); it != high.end(); ++it)
+			copied.insert(*it);
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << "adjacent shards: 1000000 inserts " << btime << " ms";
+		bstart = clock();
+		low.join(high);
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << ", join " << btime << " ms, size " << low.size() << std::endl;
+		bstart = clock();
+		for (int i = 0; i < 1000; i++) {
+			ranked.split(static_cast<int>((i * 7919L) % 1000000), ranked_right);
+			ranked.join(ranked_right);
+		}
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << "1000 splits and joins of an order statistics map: " << btime << " ms, size " << ranked.size() << std::endl;
+		copied = evens;
+		bstart = clock();
+		for (ft::map<int, int>::iterator it = odds.begin(); it != odds.end(); ++it)
+			copied.insert(*it);
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << "interleaved shards: 1000000 inserts " << btime << " ms";
+		bstart = clock();
+		evens.set_union(odds);
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << ", set_union " << btime << " ms, size " << evens.size() << std::endl;
+		for (int i = 0; i < 1000; i++)
+			odds[i * 1999] = i;
+		bstart = clock();
+		evens.set_difference(odds);
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << "difference with 1000 keys: " << btime << " ms, size " << evens.size();
+		bstart = clock();
+		evens.set_intersection(low);
+		btime = static_cast<double>(clock() - bstart) * 1000 / CLOCKS_PER_SEC;
+		std::cout << ", intersection with 2000000 keys: " << btime << " ms, size " << evens.size() << std::endl;
+	}
+
+	return (0);
+}
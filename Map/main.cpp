@@ -13,7 +13,83 @@
 //clang++ -Wall -Werror -Wextra --std=c++98 main.cpp
 
 #include "Map.hpp"
+#include "../List/MemoryResource.hpp"
+//After Map.hpp on purpose: Libraries.hpp of List/ is skipped, the allocators must not need it
+#include "../List/PoolAllocator.hpp"
+#include "../List/ArenaAllocator.hpp"
 #include <map>
+#include <vector>
+
+//std::allocator counting the objects it serves, to check what the tree takes from it.
+//Once budget allocations are served it throws std::bad_alloc, a negative budget never runs out.
+template <typename T>
+class CountingAllocator : public std::allocator<T>
+{
+public:
+	static long	live;
+	static long	budget;
+
+	template <typename U>
+	struct rebind {
+		typedef CountingAllocator<U> other;
+	};
+
+	CountingAllocator(void) : std::allocator<T>() {};
+	CountingAllocator(const CountingAllocator &copy) : std::allocator<T>(copy) {};
+	template <typename U>
+	CountingAllocator(const CountingAllocator<U> &) : std::allocator<T>() {};
+
+	T*		allocate(std::size_t n, const void * = 0) {
+		if (!budget)
+			throw std::bad_alloc();
+		if (budget > 0)
+			budget--;
+		live += n;
+		return (std::allocator<T>::allocate(n));
+	};
+
+	void	deallocate(T *p, std::size_t n) {
+		live -= n;
+		std::allocator<T>::deallocate(p, n);
+	};
+};
+
+template <typename T>
+long	CountingAllocator<T>::live = 0;
+
+template <typename T>
+long	CountingAllocator<T>::budget = -1;
+
+//memory_resource counting the bytes it takes from new_delete_resource()
+class CountingResource : public ft::memory_resource
+{
+public:
+	std::size_t	bytes;
+
+	CountingResource(void) : bytes(0) {};
+
+protected:
+	virtual void*	do_allocate(std::size_t size, std::size_t alignment) {
+		bytes += size;
+		return (ft::new_delete_resource()->allocate(size, alignment));
+	};
+
+	virtual void	do_deallocate(void *p, std::size_t size, std::size_t alignment) {
+		bytes -= size;
+		ft::new_delete_resource()->deallocate(p, size, alignment);
+	};
+
+	virtual bool	do_is_equal(const ft::memory_resource &other) const {
+		return (this == &other);
+	};
+};
+
+//Layout of a map<int, int> node before the color went into the parent address
+struct WideNode {
+	void				*links[3];
+	std::pair<int, int>	content;
+	ft::color_t			color;
+};
 
 //Inorder traversal print
 template < typename Key, typename T >
@@ -70,30 +146,220 @@ void	printMap(std::map<Key, T> &m) {
 	}
 };
 
-//Level traversal print
+//Level traversal print, sentinels are skipped
 template < typename Key, typename T >
-void	printLevelNode(ft::Node<Key, T> *n) {
-	if (!n || (n->_color == 2))
+void	printLevelNode(ft::Node<Key, T> *n, ft::Node<Key, T> *end_left, ft::Node<Key, T> *end_right) {
+	if (!n || (n == end_left) || (n == end_right))
 		return ;
 	std::cout << "ft_: first: " << n->_content.first;
 	std::cout << ", second: " << n->_content.second;
-	std::cout << ", color: " << n->_color << std::endl;
+	std::cout << ", color: " << n->color() << std::endl;
 
-	printLevelNode(n->_left);
-	printLevelNode(n->_right);
+	printLevelNode(n->_left, end_left, end_right);
+	printLevelNode(n->_right, end_left, end_right);
 };
 
 template < typename Key, typename T >
 void	printLevelMap(ft::map<Key, T> &m) {
 	typename ft::map<Key, T>::iterator	it = m.begin();
 
-	while (it.get_root()->_parent)
+	while (it.get_root()->parent())
 		it++;
 	std::cout << std::endl << "Level traversal:" << std::endl;
-	printLevelNode(it.get_root());
+	printLevelNode(it.get_root(), m.rend().get_root(), m.end().get_root());
 	std::cout << std::endl;
 };
 
+//Black height of a subtree, -1 if it breaks a red-black rule, the key order or a parent link
+template < typename Key, typename T >
+int		blackHeight(ft::Node<Key, T> *n, ft::Node<Key, T> *end_left, ft::Node<Key, T> *end_right) {
+	int	left;
+	int	right;
+
+	if (!n || (n == end_left) || (n == end_right))
+		return (1);
+	left = blackHeight(n->_left, end_left, end_right);
+	right = blackHeight(n->_right, end_left, end_right);
+	if ((left < 0) || (left != right))
+		return (-1);
+	if (n->_left && (n->_left->parent() != n))
+		return (-1);
+	if (n->_right && (n->_right->parent() != n))
+		return (-1);
+	if (n->_left && (n->_left != end_left) && !(n->_left->_content.first < n->_content.first))
+		return (-1);
+	if (n->_right && (n->_right != end_right) && !(n->_content.first < n->_right->_content.first))
+		return (-1);
+	if ((n->color() == ft::RED) && ((n->_left && (n->_left->color() == ft::RED))
+		|| (n->_right && (n->_right->color() == ft::RED))))
+		return (-1);
+	return (left + (n->color() == ft::BLACK));
+};
+
+template < typename Key, typename T, class Compare, class Alloc >
+int		blackHeight(ft::RBTree<Key, T, Compare, Alloc> &tree) {
+	return (blackHeight(tree._root, tree._end_left, tree._end_right));
+};
+
+//Checks the tree of a map: red-black rules, black root and sentinels below the extreme nodes
+template < typename Key, typename T, class Compare, class Alloc, class Augment >
+bool	validMap(ft::map<Key, T, Compare, Alloc, Augment> &m) {
+	ft::Node<Key, T>	*root;
+
+	if (m.empty())
+		return (m.begin() == m.end());
+	root = m.begin().get_root();
+	while (root->parent())
+		root = root->parent();
+	return ((root->color() == ft::BLACK) && (blackHeight(root, m.rend().get_root(), m.end().get_root()) > 0)
+		&& (m.rend().get_root()->color() == ft::BLACK) && (m.end().get_root()->color() == ft::BLACK)
+		&& (m.begin().get_root()->_left == m.rend().get_root())
+		&& (m.rbegin().get_root()->_right == m.end().get_root()));
+};
+
+//Size of a subtree of an order statistics tree, -1 if a node does not keep the size of its subtree
+template < typename Key, typename T >
+long	subtreeSize(ft::Node<Key, T> *n, ft::Node<Key, T> *end_left, ft::Node<Key, T> *end_right) {
+	long	left;
+	long	right;
+
+	if (!n || (n == end_left) || (n == end_right))
+		return (0);
+	left = subtreeSize(n->_left, end_left, end_right);
+	right = subtreeSize(n->_right, end_left, end_right);
+	if ((left < 0) || (right < 0)
+		|| (static_cast<ft::AugmentedNode<Key, T, std::size_t> *>(n)->_data != static_cast<std::size_t>(left + right + 1)))
+		return (-1);
+	return (left + right + 1);
+};
+
+//Checks a map as validMap() does, and the subtree size every node keeps
+template < typename Key, typename T, class Compare, class Alloc >
+bool	validRanks(ft::map<Key, T, Compare, Alloc, ft::order_statistics> &m) {
+	ft::Node<Key, T>	*root;
+
+	if (m.empty())
+		return (validMap(m));
+	root = m.begin().get_root();
+	while (root->parent())
+		root = root->parent();
+	return (validMap(m) && (subtreeSize(root, m.rend().get_root(), m.end().get_root()) == static_cast<long>(m.size())));
+};
+
+//Sum of the values of a range of keys
+struct Volume {
+	typedef long	summary_type;
+
+	static long	identity(void) {
+		return (0);
+	};
+
+	static long	lift(const int &, const int &value) {
+		return (value);
+	};
+
+	static long	combine(long left, long right) {
+		return (left + right);
+	};
+};
+
+//Interval tree: intervals keyed by their start, mapped to their end, summarized by the highest end
+struct HighestEnd {
+	typedef int	summary_type;
+
+	static int	identity(void) {
+		return (std::numeric_limits<int>::min());
+	};
+
+	static int	lift(const int &, const int &end) {
+		return (end);
+	};
+
+	static int	combine(int left, int right) {
+		return (left < right ? right : left);
+	};
+};
+
+//First and last keys of a range: combine() is not commutative, the key order must be kept
+struct Span {
+	struct summary_type {
+		int		first;
+		int		last;
+		bool	empty;
+
+		bool	operator==(const summary_type &other) const {
+			return ((empty && other.empty) || (!empty && !other.empty
+				&& (first == other.first) && (last == other.last)));
+		};
+	};
+
+	static summary_type	identity(void) {
+		summary_type	none = {0, 0, true};
+
+		return (none);
+	};
+
+	static summary_type	lift(const int &key, const int &) {
+		summary_type	one = {key, key, false};
+
+		return (one);
+	};
+
+	static summary_type	combine(const summary_type &left, const summary_type &right) {
+		summary_type	both = {left.first, right.last, false};
+
+		if (left.empty)
+			return (right);
+		if (right.empty)
+			return (left);
+		return (both);
+	};
+};
+
+//Checks the summary every node of a monoid_summary map keeps against its subtree, returned in summary
+template < class Monoid, typename Key, typename T >
+bool	validSummary(ft::Node<Key, T> *n, ft::Node<Key, T> *end_left, ft::Node<Key, T> *end_right,
+	typename Monoid::summary_type &summary) {
+	typename Monoid::summary_type	left;
+	typename Monoid::summary_type	right;
+
+	summary = Monoid::identity();
+	if (!n || (n == end_left) || (n == end_right))
+		return (true);
+	if (!validSummary<Monoid>(n->_left, end_left, end_right, left)
+		|| !validSummary<Monoid>(n->_right, end_left, end_right, right))
+		return (false);
+	summary = Monoid::combine(Monoid::combine(left, Monoid::lift(n->_content.first, n->_content.second)), right);
+	return (static_cast<ft::AugmentedNode<Key, T, typename Monoid::summary_type> *>(n)->_data == summary);
+};
+
+template < class Monoid, typename Key, typename T, class Compare, class Alloc >
+bool	validSummaries(ft::map<Key, T, Compare, Alloc, ft::monoid_summary<Monoid> > &m) {
+	ft::Node<Key, T>				*root = m.end().get_root();
+	typename Monoid::summary_type	summary;
+
+	while (root->parent())
+		root = root->parent();
+	if (m.empty())
+		return (validMap(m) && (m.aggregate() == Monoid::identity()));
+	return (validMap(m) && validSummary<Monoid>(root, m.rend().get_root(), m.end().get_root(), summary)
+		&& (m.aggregate() == summary));
+};
+
+//Checks that a map holds the elements of a std::map, in the same order
+template < typename Key, typename T, class Compare, class Alloc, class Augment >
+bool	sameElements(std::map<Key, T> &expected, ft::map<Key, T, Compare, Alloc, Augment> &m) {
+	typename ft::map<Key, T, Compare, Alloc, Augment>::iterator	it = m.begin();
+	typename std::map<Key, T>::iterator							sit;
+
+	if (expected.size() != m.size())
+		return (false);
+	for (sit = expected.begin(); sit != expected.end(); ++sit, ++it)
+		if ((it->first != sit->first) || (it->second != sit->second))
+			return (false);
+	return (true);
+};
+
 int	main() {
 	std::cout << "MAP CREATION TESTS >>>" << std::endl;
 	ft::map<int, int>		m1;
@@ -388,6 +654,38 @@ int	main() {
 	printMap(m2);
 	printMap(m7);
 
+	std::cout << std::endl << "MAP POOL AND ARENA ALLOCATOR TESTS >>>" << std::endl;
+	typedef ft::PoolAllocator<std::pair<const int, int> >					pool_allocator;
+	typedef ft::map<int, int, std::less<int>, pool_allocator>				pool_map;
+	typedef ft::ArenaAllocator<std::pair<const int, int> >					arena_allocator;
+	typedef ft::map<int, int, std::less<int>, arena_allocator>				arena_map;
+	pool_map	pool_keys;
+	for (int i = 0; i < 10; i++)
+		pool_keys[i] = i;
+	pool_keys.erase(5);
+	std::cout << "pool: size " << pool_keys.size() << ", first " << pool_keys.begin()->first;
+	std::cout << ", last " << (--pool_keys.end())->first << std::endl;
+	pool_map	*pool_tail = new pool_map(std::less<int>(), pool_keys.get_allocator());
+	for (int i = 10; i < 20; i++)
+		(*pool_tail)[i] = i;
+	pool_keys.join(*pool_tail);
+	delete pool_tail;
+	std::cout << "pool: joined from a destroyed map, size " << pool_keys.size() << ", first ";
+	std::cout << pool_keys.begin()->first << ", last " << (--pool_keys.end())->first << std::endl;
+	pool_allocator	keys_pools = pool_keys.get_allocator();
+	pool_map		pool_swapped;
+	pool_swapped.swap(pool_keys);
+	std::cout << "pool: swapped, size " << pool_swapped.size() << ", allocator follows the nodes: ";
+	std::cout << (pool_swapped.get_allocator() == keys_pools) << " " << (pool_keys.get_allocator() != keys_pools) << std::endl;
+	ft::Arena		map_arena;
+	std::less<int>	arena_less;
+	arena_map		arena_keys(arena_less, arena_allocator(map_arena));
+	for (int i = 0; i < 10; i++)
+		arena_keys[i] = i;
+	arena_keys.erase(5);
+	std::cout << "arena: size " << arena_keys.size() << ", first " << arena_keys.begin()->first;
+	std::cout << ", last " << (--arena_keys.end())->first << std::endl;
+
 	std::cout << std::endl << "MAP COMPARISON TESTS >>>" << std::endl;
 	std::cout << "ft_ maps for comparison: " << std::endl;
 	printMap(m2);
@@ -401,5 +699,695 @@ int	main() {
 	std::cout << "std: equal: " << (sm20 == sm70) << ", not equal: " << (sm20 != sm70);
 	std::cout << ", >: " << (sm20 > sm70) << ", >=: " << (sm20 >= sm70) << ", <: " << (sm20 < sm70);
 	std::cout << ", <=: " << (sm20 <= sm70) << std::endl;
+	std::cout << std::endl << "MAP ALLOCATOR TESTS >>>" << std::endl;
+	typedef CountingAllocator<std::pair<const int, int> >					counting_allocator;
+	typedef ft::map<int, int, std::less<int>, counting_allocator>			counted_map;
+	{
+		counted_map	cm1;
+		counted_map	cm2(arr1, arr1 + 3);
+
+		std::cout << "nodes taken by two maps with sentinels: ";
+		std::cout << CountingAllocator<ft::Node<int, int> >::live << std::endl;
+		for (int i = 10; i < 20; i++)
+			cm1[i] = i * 2;
+		cm1.erase(15);
+		cm1.swap(cm2);
+		std::cout << "after 10 inserts, 1 erase and a swap: ";
+		std::cout << CountingAllocator<ft::Node<int, int> >::live << ", sizes: " << cm1.size() << " " << cm2.size() << std::endl;
+		counted_map	cm3(cm2);
+		cm3.clear();
+		std::cout << "copy cleared: " << CountingAllocator<ft::Node<int, int> >::live << std::endl;
+	}
+	std::cout << "all maps destroyed: " << CountingAllocator<ft::Node<int, int> >::live << std::endl;
+	std::cout << "pairs taken directly: " << counting_allocator::live << std::endl;
+
+	std::cout << std::endl << "MAP memory_resource TESTS >>>" << std::endl;
+	typedef ft::pmr::map<int, int>::type	pmr_map;
+	ft::unsynchronized_pool_resource		pooled;
+	ft::monotonic_buffer_resource			monotonic;
+	pmr_map									pm1(std::less<int>(), &pooled);
+	pmr_map									pm2(arr1, arr1 + 3, std::less<int>(), &monotonic);
+	for (int i = 0; i < 100; i++)
+		pm1[i] = i;
+	for (int i = 0; i < 100; i += 2)
+		pm1.erase(i);
+	for (int i = 100; i < 150; i++)
+		pm1[i] = i;
+	std::cout << "pool: size " << pm1.size() << ", first " << pm1.begin()->first;
+	std::cout << ", last " << (--pm1.end())->first << std::endl;
+	pm1.swap(pm2);
+	std::cout << "resources follow the swap: " << (pm1.get_allocator().resource() == &monotonic);
+	std::cout << " " << (pm2.get_allocator().resource() == &pooled) << ", sizes: ";
+	std::cout << pm1.size() << " " << pm2.size() << std::endl;
+
+	std::cout << std::endl << "MAP BOUNDS TESTS >>>" << std::endl;
+	ft::map<int, int>						bounded;
+	std::map<int, int>						sbounded;
+	ft::map<int, int, std::greater<int> >	reversed;
+	std::map<int, int, std::greater<int> >	sreversed;
+	bool									bounds_match = true;
+	for (int i = 0; i < 64; i += 3) {
+		bounded[i] = i;
+		sbounded[i] = i;
+		reversed[i] = i;
+		sreversed[i] = i;
+	}
+	for (int i = -2; i < 67; i++) {
+		if ((bounded.lower_bound(i) == bounded.end()) != (sbounded.lower_bound(i) == sbounded.end())
+			|| (bounded.upper_bound(i) == bounded.end()) != (sbounded.upper_bound(i) == sbounded.end())
+			|| (reversed.lower_bound(i) == reversed.end()) != (sreversed.lower_bound(i) == sreversed.end())
+			|| (reversed.upper_bound(i) == reversed.end()) != (sreversed.upper_bound(i) == sreversed.end()))
+			bounds_match = false;
+		else if (((bounded.lower_bound(i) != bounded.end()) && (bounded.lower_bound(i)->first != sbounded.lower_bound(i)->first))
+			|| ((bounded.upper_bound(i) != bounded.end()) && (bounded.upper_bound(i)->first != sbounded.upper_bound(i)->first))
+			|| ((reversed.lower_bound(i) != reversed.end()) && (reversed.lower_bound(i)->first != sreversed.lower_bound(i)->first))
+			|| ((reversed.upper_bound(i) != reversed.end()) && (reversed.upper_bound(i)->first != sreversed.upper_bound(i)->first)))
+			bounds_match = false;
+		if (((bounded.find(i) == bounded.end()) != (sbounded.find(i) == sbounded.end()))
+			|| (bounded.count(i) != sbounded.count(i)) || (reversed.count(i) != sreversed.count(i)))
+			bounds_match = false;
+	}
+	std::cout << "bounds, find and count match std::map for both orders: " << bounds_match << std::endl;
+	const ft::map<int, int>	&cbounded = bounded;
+	std::cout << "equal_range(9): [" << cbounded.equal_range(9).first->first << ", ";
+	std::cout << cbounded.equal_range(9).second->first << "), equal_range(10): [";
+	std::cout << cbounded.equal_range(10).first->first << ", " << cbounded.equal_range(10).second->first << ")" << std::endl;
+	std::cout << "reversed: lower_bound(10) " << reversed.lower_bound(10)->first;
+	std::cout << ", upper_bound(9) " << reversed.upper_bound(9)->first << ", find(-3) is end: ";
+	std::cout << (bounded.find(-3) == bounded.end()) << std::endl;
+
+	std::cout << std::endl << "MAP UPSERT TESTS >>>" << std::endl;
+	{
+		counted_map						upserted;
+		std::pair<counted_map::iterator, bool>	first_insert = upserted.insert(std::make_pair(7, 70));
+		long							nodes_before;
+
+		for (int i = 0; i < 16; i++)
+			upserted[i] += i;
+		nodes_before = CountingAllocator<ft::Node<int, int> >::live;
+		std::pair<counted_map::iterator, bool>	again = upserted.insert(std::make_pair(7, 0));
+		upserted[7] += 1;
+		upserted[15] += 1;
+		std::cout << "first insert: " << first_insert.first->first << " " << first_insert.second;
+		std::cout << ", duplicate insert: " << again.first->first << " => " << again.first->second << " " << again.second;
+		std::cout << ", after operator[]: " << upserted[7] << " " << upserted[15] << std::endl;
+		std::cout << "nodes allocated by the duplicate insert and operator[] on present keys: ";
+		std::cout << CountingAllocator<ft::Node<int, int> >::live - nodes_before << ", size " << upserted.size() << std::endl;
+		std::cout << "iterator of a new key: " << upserted.insert(std::make_pair(-1, 1)).first->first;
+		std::cout << ", begin: " << upserted.begin()->first << std::endl;
+	}
+
+	std::cout << std::endl << "MAP CHURN TESTS >>>" << std::endl;
+	{
+		ft::map<int, int>				churned;
+		std::map<int, int>				schurned;
+		bool							churn_valid = true;
+		bool							churn_match = true;
+
+		for (int i = 0; i < 4000; i++) {
+			int	key = static_cast<int>((i * 7919L) % 1009);
+
+			if ((i % 3) == 2) {
+				if (churned.count(key))
+					churned.erase(key);
+				schurned.erase(key);
+			}
+			else {
+				churned[key] = i;
+				schurned[key] = i;
+			}
+			if (!(i % 97) && !validMap(churned))
+				churn_valid = false;
+		}
+		ft::map<int, int>::iterator	kept = churned.find(schurned.rbegin()->first);
+		ft::map<int, int>::iterator	middle = churned.find((++schurned.begin())->first);
+		while (churned.size() > 2) {
+			ft::map<int, int>::iterator	next = churned.begin();
+			int							key;
+
+			if (next == middle)
+				++next;
+			key = next->first;
+			churned.erase(key);
+			schurned.erase(key);
+			if (!(churned.size() % 50) && !validMap(churned))
+				churn_valid = false;
+		}
+		ft::map<int, int>::iterator			it = churned.begin();
+		for (std::map<int, int>::iterator sit = schurned.begin(); sit != schurned.end(); ++sit, ++it)
+			if ((it->first != sit->first) || (it->second != sit->second))
+				churn_match = false;
+		std::cout << "valid red-black trees: " << churn_valid << ", same elements as std::map: " << churn_match;
+		std::cout << ", iterators kept through erases: " << (kept->first == schurned.rbegin()->first);
+		std::cout << " " << (middle == churned.begin()) << std::endl;
+		churned.erase(middle->first);
+		churned.erase(kept->first);
+		std::cout << "emptied: size " << churned.size() << ", begin is end: " << (churned.begin() == churned.end());
+		churned[3] = 3;
+		std::cout << ", reused: begin " << churned.begin()->first << ", rbegin " << churned.rbegin()->first;
+		std::cout << ", valid: " << validMap(churned) << std::endl;
+	}
+
+	std::cout << std::endl << "MAP TREE WALK TESTS >>>" << std::endl;
+	{
+		ft::RBTree<int, int>	chain;
+
+		for (int i = 0; i < 100000; i++)
+			chain.insert(i, -i);
+		ft::RBTree<int, int>	copied(chain);
+		ft::RBTree<int, int>	assigned;
+		assigned.insert(5, 5);
+		assigned = copied;
+		for (int i = 0; i < 100000; i += 2)
+			assigned.erase(i);
+		std::cout << "ascending chain: size " << chain._size << ", valid " << (blackHeight(chain) > 0);
+		std::cout << ", copy: size " << copied._size << ", valid " << (blackHeight(copied) > 0);
+		std::cout << ", ends " << copied._end_left->parent()->_content.first << " " << copied._end_right->parent()->_content.first;
+		std::cout << std::endl << "assigned then odd keys kept: size " << assigned._size;
+		std::cout << ", valid " << (blackHeight(assigned) > 0) << ", first " << assigned._end_left->parent()->_content.first;
+		std::cout << " => " << assigned._end_left->parent()->_content.second << std::endl;
+		chain.clear();
+		std::cout << "cleared: size " << chain._size << ", root " << chain._root << std::endl;
+	}
+
+	std::cout << std::endl << "MAP CLONE TESTS >>>" << std::endl;
+	{
+		typedef CountingAllocator<ft::Node<int, int> >	node_counter;
+		counted_map										source;
+		bool											same = true;
+
+		for (int i = 0; i < 1000; i++)
+			source[static_cast<int>((i * 7919L) % 1000)] = i;
+		counted_map										cloned(source);
+		counted_map::iterator							cit = cloned.begin();
+		for (counted_map::iterator sit = source.begin(); sit != source.end(); ++sit, ++cit)
+			if ((sit->first != cit->first) || (sit->second != cit->second)
+				|| (sit.get_root()->color() != cit.get_root()->color())
+				|| ((sit.get_root()->parent() == NULL) != (cit.get_root()->parent() == NULL)))
+				same = false;
+		std::cout << "clone: size " << cloned.size() << ", same keys, values, colors and root: " << same;
+		std::cout << ", valid " << validMap(cloned) << ", shares no node: " << (cloned.begin() != source.begin());
+		std::cout << ", ends " << cloned.begin()->first << " " << cloned.rbegin()->first << std::endl;
+		counted_map										assigned;
+		assigned[-5] = 5;
+		long											nodes_before = node_counter::live;
+		node_counter::budget = 600;
+		try {
+			assigned = source;
+		}
+		catch (std::bad_alloc &) {
+			std::cout << "assignment failing after 600 nodes: size " << assigned.size();
+			std::cout << ", nodes rolled back: " << (node_counter::live == nodes_before - 1) << std::endl;
+		}
+		node_counter::budget = 600;
+		try {
+			counted_map	failed(source);
+		}
+		catch (std::bad_alloc &) {
+			std::cout << "copy failing after 600 nodes: nodes rolled back: " << (node_counter::live == nodes_before - 1) << std::endl;
+		}
+		node_counter::budget = -1;
+		assigned = source;
+		assigned.erase(0);
+		assigned[5000] = 1;
+		std::cout << "assigned again: size " << assigned.size() << ", valid " << validMap(assigned);
+		std::cout << ", ends " << assigned.begin()->first << " " << assigned.rbegin()->first << std::endl;
+		assigned = counted_map();
+		std::cout << "assigned an empty map: size " << assigned.size() << ", begin is end: " << (assigned.begin() == assigned.end()) << std::endl;
+	}
+
+	std::cout << std::endl << "MAP SORTED BUILD TESTS >>>" << std::endl;
+	{
+		std::pair<int, int>	sorted[1000];
+		bool				built_valid = true;
+
+		for (int i = 0; i < 1000; i++)
+			sorted[i] = std::make_pair(i * 3, i);
+		for (int n = 0; n <= 70; n++) {
+			ft::map<int, int>	built(sorted, sorted + n);
+			if (!validMap(built) || (built.size() != static_cast<size_t>(n))
+				|| (n && ((built.begin()->first != 0) || (built.rbegin()->first != (n - 1) * 3))))
+				built_valid = false;
+		}
+		std::cout << "sizes 0 to 70 built valid with the right ends: " << built_valid << std::endl;
+		ft::map<int, int>	full(sorted, sorted + 1000);
+		ft::map<int, int>	from_map(full.begin(), full.end());
+		ft::Node<int, int>	*root = full.begin().get_root();
+		while (root->parent())
+			root = root->parent();
+		std::cout << "1000 sorted: black height " << blackHeight(root, full.rend().get_root(), full.end().get_root()) << ", root " << root->_content.first;
+		std::cout << ", from an ft::map: size " << from_map.size() << ", equal " << (from_map == full) << std::endl;
+		std::pair<int, int>	mixed[] = {std::make_pair(1, 1), std::make_pair(4, 4), std::make_pair(9, 9),
+			std::make_pair(4, 40), std::make_pair(2, 2), std::make_pair(12, 12), std::make_pair(0, 0)};
+		ft::map<int, int>	fallback(mixed, mixed + 7);
+		std::map<int, int>	sfallback(mixed, mixed + 7);
+		std::cout << "run broken by a duplicate: valid " << validMap(fallback) << ", ft_:";
+		for (ft::map<int, int>::iterator it = fallback.begin(); it != fallback.end(); ++it)
+			std::cout << " " << it->first << "=" << it->second;
+		std::cout << ", std:";
+		for (std::map<int, int>::iterator it = sfallback.begin(); it != sfallback.end(); ++it)
+			std::cout << " " << it->first << "=" << it->second;
+		std::cout << std::endl;
+		fallback.insert(sorted, sorted + 5);
+		std::cout << "sorted range into a non-empty map: size " << fallback.size() << ", valid " << validMap(fallback) << std::endl;
+		typedef CountingAllocator<ft::Node<int, int> >	node_counter;
+		long											nodes_before = node_counter::live;
+		node_counter::budget = 500;
+		try {
+			counted_map	failed(sorted, sorted + 1000);
+		}
+		catch (std::bad_alloc &) {
+			std::cout << "build failing after 500 nodes: nodes rolled back: " << (node_counter::live == nodes_before) << std::endl;
+		}
+		node_counter::budget = -1;
+	}
+
+	std::cout << std::endl << "MAP HINTED INSERT TESTS >>>" << std::endl;
+	{
+		ft::map<int, int>			hinted;
+		std::map<int, int>			shinted;
+		ft::map<int, int>::iterator	last = hinted.end();
+		bool						hinted_match = true;
+
+		for (int i = 0; i < 3000; i++) {
+			int							key = static_cast<int>((i * 7919L) % 2003);
+			ft::map<int, int>::iterator	hint;
+
+			switch (i % 4) {
+				case 0: hint = hinted.end(); break ;
+				case 1: hint = hinted.begin(); break ;
+				case 2: hint = last; break ;
+				default: hint = hinted.lower_bound(key); break ;
+			}
+			last = hinted.insert(hint, std::make_pair(key, i));
+			shinted.insert(std::make_pair(key, i));
+			if ((last->first != key) || (last->second != shinted[key]))
+				hinted_match = false;
+		}
+		ft::map<int, int>::iterator	it = hinted.begin();
+		for (std::map<int, int>::iterator sit = shinted.begin(); sit != shinted.end(); ++sit, ++it)
+			if ((it->first != sit->first) || (it->second != sit->second))
+				hinted_match = false;
+		std::cout << "hints at end, begin, last insertion and lower_bound: size " << hinted.size();
+		std::cout << ", valid " << validMap(hinted) << ", same as std::map: " << hinted_match << std::endl;
+		ft::map<int, int>			around;
+		around.insert(around.end(), std::make_pair(10, 10));
+		around.insert(around.end(), std::make_pair(30, 30));
+		around.insert(around.find(30), std::make_pair(20, 20));
+		around.insert(around.find(20), std::make_pair(25, 25));
+		around.insert(around.find(10), std::make_pair(5, 5));
+		around.insert(around.find(10), std::make_pair(40, 40));
+		std::cout << "before and after hints, and a wrong one:";
+		for (ft::map<int, int>::iterator ait = around.begin(); ait != around.end(); ++ait)
+			std::cout << " " << ait->first;
+		std::cout << ", valid " << validMap(around) << ", duplicate keeps ";
+		std::cout << around.insert(around.begin(), std::make_pair(25, 0))->second << std::endl;
+	}
+
+	std::cout << std::endl << "MAP RANGE ERASE TESTS >>>" << std::endl;
+	{
+		typedef CountingAllocator<ft::Node<int, int> >	node_counter;
+		counted_map										ranged;
+		long											nodes_before = node_counter::live;
+
+		for (int i = 0; i < 100; i++)
+			ranged[i] = i;
+		counted_map::iterator	kept = ranged.find(10);
+		ranged.erase(ranged.find(20), ranged.find(30));
+		ranged.erase(ranged.find(90), ranged.end());
+		ranged.erase(ranged.begin(), ranged.find(5));
+		ranged.erase(ranged.find(50), ranged.find(50));
+		std::cout << "erased [20, 30), [90, end), [begin, 5) and an empty range: size " << ranged.size();
+		std::cout << ", ends " << ranged.begin()->first << " " << ranged.rbegin()->first;
+		std::cout << ", valid " << validMap(ranged) << ", iterator kept: " << kept->first;
+		std::cout << ", 20 found: " << (ranged.find(20) != ranged.end()) << std::endl;
+		std::cout << "erase of a missing key: " << ranged.erase(20) << ", of a present key: " << ranged.erase(40);
+		ranged.erase(kept);
+		std::cout << ", by iterator: size " << ranged.size() << ", valid " << validMap(ranged) << std::endl;
+		ranged.erase(ranged.begin(), ranged.end());
+		std::cout << "whole range: size " << ranged.size() << ", begin is end: " << (ranged.begin() == ranged.end());
+		std::cout << ", nodes left: " << node_counter::live - nodes_before << std::endl;
+		ranged[1] = 1;
+		std::cout << "reused: size " << ranged.size() << ", valid " << validMap(ranged) << std::endl;
+	}
+
+	std::cout << std::endl << "MAP NODE LAYOUT TESTS >>>" << std::endl;
+	{
+		CountingResource				counted;
+		ft::unsynchronized_pool_resource	nodes(&counted);
+		pmr_map								compact(std::less<int>(), &nodes);
+		ft::Node<int, int>					probe(1, 2);
+
+		for (int i = 0; i < 100000; i++)
+			compact.insert(compact.end(), std::make_pair(i, i));
+		std::cout << "map<int, int> node: " << sizeof(WideNode) << " bytes with a color field, ";
+		std::cout << sizeof(ft::Node<int, int>) << " bytes with the color in the parent address, key at offset ";
+		std::cout << reinterpret_cast<char *>(&probe._content.first) - reinterpret_cast<char *>(&probe) << std::endl;
+		std::cout << "pool resource bytes per element for 100000 keys: " << counted.bytes / compact.size() << std::endl;
+		probe.set_parent(&probe);
+		probe.set_color(ft::BLACK);
+		std::cout << "packed link: parent kept " << (probe.parent() == &probe) << ", color " << probe.color();
+		probe.set_color(ft::RED);
+		probe.set_parent(NULL);
+		std::cout << ", color kept " << probe.color() << ", parent " << probe.parent() << std::endl;
+	}
+
+	std::cout << std::endl << "MAP ORDER STATISTICS TESTS >>>" << std::endl;
+	typedef ft::map<int, int, std::less<int>, std::allocator<std::pair<const int, int> >, ft::order_statistics>	ranked_map;
+	{
+		ranked_map				ranked;
+		std::map<int, int>		sranked;
+		bool					sizes_valid = true;
+		bool					ranks_match = true;
+		std::vector<std::pair<int, int> >	sorted;
+
+		for (int i = 0; i < 4000; i++) {
+			int	key = static_cast<int>((i * 7919L) % 1009);
+
+			if ((i % 3) == 2) {
+				ranked.erase(key);
+				sranked.erase(key);
+			}
+			else if (i % 2) {
+				ranked.insert(ranked.lower_bound(key), std::make_pair(key, i));
+				sranked.insert(std::make_pair(key, i));
+			}
+			else {
+				ranked[key] = i;
+				sranked[key] = i;
+			}
+			if (!(i % 97) && !validRanks(ranked))
+				sizes_valid = false;
+		}
+		ranked.erase(ranked.find(sranked.begin()->first), ranked.lower_bound(100));
+		sranked.erase(sranked.begin(), sranked.lower_bound(100));
+		sizes_valid = sizes_valid && validRanks(ranked);
+		for (int key = -1; key <= 1010; key++) {
+			std::size_t	position = std::distance(sranked.begin(), sranked.lower_bound(key));
+
+			if (ranked.rank(key) != position)
+				ranks_match = false;
+			if (sranked.count(key) && ((ranked.select(position)->first != key)
+				|| (ranked.find(key) - ranked.begin() != static_cast<std::ptrdiff_t>(position))))
+				ranks_match = false;
+		}
+		std::cout << "valid trees with exact subtree sizes: " << sizes_valid;
+		std::cout << ", rank, select and distance match std::map: " << ranks_match << ", size " << ranked.size() << std::endl;
+		std::cout << "rank(-5) " << ranked.rank(-5) << ", rank(2000) is size: " << (ranked.rank(2000) == ranked.size());
+		std::cout << ", select(size) is end: " << (ranked.select(ranked.size()) == ranked.end());
+		std::cout << ", end - begin: " << ranked.end() - ranked.begin() << ", begin - end: " << ranked.begin() - ranked.end() << std::endl;
+
+		ranked_map				copied(ranked);
+		const ranked_map		&constant = copied;
+		ranked_map::iterator	it = copied.begin();
+
+		it++;
+		it++;
+		std::cout << "copy: valid " << validRanks(copied) << ", same median: " << (copied.nth(copied.size() / 2)->first == ranked.nth(ranked.size() / 2)->first);
+		std::cout << ", const select(0): " << constant.select(0)->first << ", const end - begin: " << constant.end() - constant.begin();
+		std::cout << ", it++ twice - begin: " << it - copied.begin() << std::endl;
+		for (int i = 0; i < 1000; i++)
+			sorted.push_back(std::make_pair(i * 2, i));
+		ranked_map				built(sorted.begin(), sorted.end());
+		built.erase(built.find(500), built.find(1500));
+		built.insert(built.end(), std::make_pair(5000, 0));
+		std::cout << "sorted build then range erase: valid " << validRanks(built) << ", size " << built.size();
+		std::cout << ", rank(1500) " << built.rank(1500) << ", nth(250) " << built.nth(250)->first;
+		built.clear();
+		std::cout << ", cleared: rank(0) " << built.rank(0) << ", select(0) is end: " << (built.select(0) == built.end()) << std::endl;
+		std::cout << "plain iterator is unchanged: " << (sizeof(ft::map<int, int>::iterator) == sizeof(ft::Iterator<int, int>));
+		std::cout << ", node " << sizeof(ft::Node<int, int>) << " bytes plain, ";
+		std::cout << sizeof(ft::order_statistics::node<int, int>::type) << " bytes with its subtree size" << std::endl;
+	}
+
+	std::cout << std::endl << "MAP AGGREGATE TESTS >>>" << std::endl;
+	typedef std::allocator<std::pair<const int, int> >										int_allocator;
+	typedef ft::map<int, int, std::less<int>, int_allocator, ft::monoid_summary<Volume> >	volume_map;
+	{
+		typedef ft::map<int, int, std::less<int>, int_allocator, ft::monoid_summary<Span> >			span_map;
+		typedef ft::map<int, int, std::less<int>, int_allocator, ft::monoid_summary<HighestEnd> >	interval_map;
+		volume_map				volumes;
+		span_map				spans;
+		ranked_map				counted;
+		std::map<int, int>		svolumes;
+		bool					summaries_valid = true;
+		bool					volumes_match = true;
+		bool					spans_match = true;
+		bool					counts_match = true;
+
+		for (int i = 0; i < 4000; i++) {
+			int	key = static_cast<int>((i * 7919L) % 1009);
+
+			if ((i % 3) == 2) {
+				volumes.erase(key);
+				spans.erase(key);
+				counted.erase(key);
+				svolumes.erase(key);
+			}
+			else {
+				volumes.insert(volumes.upper_bound(key), std::make_pair(key, i % 100));
+				spans[key] = i;
+				counted[key] = i;
+				svolumes.insert(std::make_pair(key, i % 100));
+			}
+			if (!(i % 97) && (!validSummaries(volumes) || !validSummaries(spans)))
+				summaries_valid = false;
+		}
+		volumes.erase(volumes.lower_bound(300), volumes.lower_bound(400));
+		spans.erase(spans.lower_bound(300), spans.lower_bound(400));
+		svolumes.erase(svolumes.lower_bound(300), svolumes.lower_bound(400));
+		summaries_valid = summaries_valid && validSummaries(volumes) && validSummaries(spans);
+		for (int lo = -2; lo <= 1012; lo += 7)
+			for (int hi = lo - 1; hi <= 1012; hi += 13) {
+				long								sum = 0;
+				Span::summary_type					span = Span::identity();
+				std::map<int, int>::iterator		it;
+
+				for (it = svolumes.lower_bound(lo); (it != svolumes.end()) && (it->first < hi); ++it) {
+					sum += it->second;
+					span = Span::combine(span, Span::lift(it->first, 0));
+				}
+				if (volumes.aggregate(lo, hi) != sum)
+					volumes_match = false;
+				if (!(spans.aggregate(lo, hi) == span))
+					spans_match = false;
+				if ((hi >= lo) && (counted.aggregate(lo, hi) != counted.rank(hi) - counted.rank(lo)))
+					counts_match = false;
+			}
+		std::cout << "valid trees with exact summaries: " << summaries_valid << ", range sums match std::map: " << volumes_match;
+		std::cout << ", ordered spans match: " << spans_match << ", counts match ranks: " << counts_match << std::endl;
+		std::cout << "whole map: " << volumes.aggregate() << ", empty range: " << volumes.aggregate(500, 500);
+		std::cout << ", reversed range: " << volumes.aggregate(600, 500) << ", span [0, 1009): ";
+		std::cout << spans.aggregate(0, 1009).first << " " << spans.aggregate(0, 1009).last << std::endl;
+
+		volume_map				copied(volumes);
+		volume_map				built;
+		std::vector<std::pair<int, int> >	sorted;
+
+		for (int i = 0; i < 1000; i++)
+			sorted.push_back(std::make_pair(i, i));
+		built.insert(sorted.begin(), sorted.end());
+		std::cout << "copy: valid " << validSummaries(copied) << ", same total " << (copied.aggregate() == volumes.aggregate());
+		std::cout << ", sorted build: valid " << validSummaries(built) << ", sum [10, 20) " << built.aggregate(10, 20);
+		copied.clear();
+		std::cout << ", cleared: total " << copied.aggregate() << std::endl;
+		built[500] = 10000;
+		std::cout << "value changed through operator[]: valid " << validSummaries(built);
+		built.refresh(built.find(500));
+		std::cout << ", refreshed: valid " << validSummaries(built) << ", sum [500, 501) " << built.aggregate(500, 501) << std::endl;
+
+		interval_map			intervals;
+		std::vector<std::pair<int, int> >	sintervals;
+		bool					overlaps_match = true;
+
+		for (int i = 0; i < 300; i++) {
+			int	start = static_cast<int>((i * 7919L) % 10007);
+			int	end = start + 1 + static_cast<int>((i * 104729L) % 97);
+
+			if (intervals.insert(std::make_pair(start, end)).second)
+				sintervals.push_back(std::make_pair(start, end));
+		}
+		for (int a = 0; a < 10100; a += 37)
+			for (int b = a + 1; b < a + 200; b += 29) {
+				bool	overlap = false;
+
+				for (std::size_t i = 0; i < sintervals.size(); i++)
+					if ((sintervals[i].first < b) && (a < sintervals[i].second))
+						overlap = true;
+				if ((intervals.aggregate(intervals.begin()->first, b) > a) != overlap)
+					overlaps_match = false;
+			}
+		std::cout << "interval tree: " << intervals.size() << " intervals, overlap of [a, b) as highest end of starts below b: ";
+		std::cout << overlaps_match << ", valid " << validSummaries(intervals) << std::endl;
+	}
+
+	std::cout << std::endl << "MAP SPLIT AND JOIN TESTS >>>" << std::endl;
+	{
+		typedef CountingAllocator<ft::Node<int, int> >	node_counter;
+		counted_map				whole;
+		counted_map				right;
+		counted_map				probe;
+		long					nodes_before;
+		bool					splits_valid = true;
+
+		for (int i = 0; i < 1000; i++)
+			whole[i] = i;
+		nodes_before = node_counter::live;
+		counted_map::iterator	kept = whole.find(700);
+		whole.split(500, right);
+		std::cout << "split at 500: sizes " << whole.size() << " " << right.size() << ", ends " << whole.begin()->first;
+		std::cout << " " << whole.rbegin()->first << " " << right.begin()->first << " " << right.rbegin()->first;
+		std::cout << ", valid " << validMap(whole) << " " << validMap(right) << ", iterator kept: " << kept->first;
+		std::cout << ", nodes made: " << node_counter::live - nodes_before << std::endl;
+		whole.join(right);
+		std::cout << "joined: size " << whole.size() << ", right empty: " << right.empty() << ", valid " << validMap(whole);
+		std::cout << ", iterator kept: " << (whole.find(700) == kept) << std::endl;
+		whole.split(-1, right);
+		std::cout << "split below the first key: sizes " << whole.size() << " " << right.size();
+		right.split(1000, whole);
+		std::cout << ", above the last: sizes " << right.size() << " " << whole.size() << ", valid " << validMap(right) << std::endl;
+		right.split(250, whole);
+		whole.join(right);
+		std::cout << "joined in front: size " << whole.size() << ", ends " << whole.begin()->first << " " << whole.rbegin()->first;
+		std::cout << ", valid " << validMap(whole) << std::endl;
+		for (int i = 0; i < 200; i++) {
+			int	key = static_cast<int>((i * 7919L) % 1100) - 50;
+
+			whole.split(key, right);
+			if (!validMap(whole) || !validMap(right) || (whole.size() + right.size() != 1000)
+				|| (!whole.empty() && (whole.rbegin()->first >= key))
+				|| (!right.empty() && (right.begin()->first < key)))
+				splits_valid = false;
+			if (i % 2)
+				whole.join(right);
+			else {
+				right.join(whole);
+				whole.swap(right);
+			}
+			if (!validMap(whole) || (whole.size() != 1000))
+				splits_valid = false;
+		}
+		std::cout << "200 splits at random keys and joins back: valid " << splits_valid;
+		std::cout << ", nodes made: " << node_counter::live - nodes_before << std::endl;
+		for (int i = 990; i < 1010; i++)
+			probe[i] = -i;
+		whole.join(probe);
+		std::cout << "overlapping join as a union: size " << whole.size() << ", left in other: " << probe.size();
+		std::cout << ", values " << whole[995] << " " << whole[1005] << ", valid " << validMap(whole) << std::endl;
+
+		ranked_map				ranked;
+		ranked_map				ranked_right;
+		volume_map				volumes;
+		volume_map				volumes_right;
+
+		for (int i = 0; i < 1000; i++) {
+			ranked[i * 3] = i;
+			volumes.insert(std::make_pair(i * 3, i));
+		}
+		ranked.split(1500, ranked_right);
+		volumes.split(1500, volumes_right);
+		std::cout << "augmented split: sizes " << ranked.size() << " " << ranked_right.size() << ", valid ranks " << validRanks(ranked);
+		std::cout << " " << validRanks(ranked_right) << ", valid sums " << validSummaries(volumes) << " " << validSummaries(volumes_right);
+		std::cout << ", totals " << volumes.aggregate() << " " << volumes_right.aggregate() << std::endl;
+		ranked_right.join(ranked);
+		volumes_right.join(volumes);
+		std::cout << "augmented join: size " << ranked_right.size() << ", valid " << validRanks(ranked_right);
+		std::cout << " " << validSummaries(volumes_right) << ", nth(500) " << ranked_right.nth(500)->first;
+		std::cout << ", total " << volumes_right.aggregate() << std::endl;
+	}
+
+	std::cout << std::endl << "MAP SET OPERATIONS TESTS >>>" << std::endl;
+	{
+		typedef CountingAllocator<ft::Node<int, int> >	node_counter;
+		bool					sets_match = true;
+		bool					sets_valid = true;
+		long					nodes_before = node_counter::live;
+
+		for (int round = 0; round < 6; round++) {
+			int					small_step = (round % 2) ? 2 : 7;
+			int					large_step = (round % 2) ? 3 : 2;
+			int					count = (round < 2) ? 5 : ((round < 4) ? 300 : 2000);
+			counted_map			a;
+			counted_map			b;
+			std::map<int, int>	sa;
+			std::map<int, int>	sb;
+
+			for (int i = 0; i < count; i++) {
+				a[i * small_step] = i;
+				sa[i * small_step] = i;
+			}
+			for (int i = 0; i < 1000; i++) {
+				b[i * large_step + round] = -i;
+				sb[i * large_step + round] = -i;
+			}
+			counted_map			united(a);
+			counted_map			other(b);
+			counted_map			intersected(a);
+			counted_map			subtracted(a);
+			std::map<int, int>	sunited(sa);
+			std::map<int, int>	sother;
+			std::map<int, int>	sintersected;
+			std::map<int, int>	ssubtracted;
+
+			for (std::map<int, int>::iterator it = sb.begin(); it != sb.end(); ++it)
+				if (!sunited.insert(*it).second)
+					sother.insert(*it);
+			for (std::map<int, int>::iterator it = sa.begin(); it != sa.end(); ++it)
+				(sb.count(it->first) ? sintersected : ssubtracted).insert(*it);
+			if (round % 3)
+				united.set_union(other);
+			else {
+				other.set_union(united);
+				united.swap(other);
+			}
+			intersected.set_intersection(b);
+			subtracted.set_difference(b);
+			sets_valid = sets_valid && validMap(united) && validMap(other) && validMap(intersected)
+				&& validMap(subtracted) && (b.size() == 1000);
+			sets_match = sets_match && sameElements(sintersected, intersected) && sameElements(ssubtracted, subtracted);
+			if (round % 3)
+				sets_match = sets_match && sameElements(sunited, united) && sameElements(sother, other);
+			else
+				sets_match = sets_match && (united.size() == sunited.size()) && (other.size() == sother.size());
+		}
+		std::cout << "union, intersection and difference of small and large maps match std::map: " << sets_match;
+		std::cout << ", valid " << sets_valid << ", nodes left: " << node_counter::live - nodes_before << std::endl;
+
+		counted_map				evens;
+		counted_map				odds;
+		counted_map				same;
+
+		for (int i = 0; i < 10; i++) {
+			evens[i * 2] = i;
+			odds[i * 2 + 1] = i;
+		}
+		nodes_before = node_counter::live;
+		evens.set_union(odds);
+		std::cout << "union of evens and odds: size " << evens.size() << ", other " << odds.size();
+		std::cout << ", nodes made: " << node_counter::live - nodes_before;
+		same = evens;
+		evens.set_intersection(evens);
+		evens.set_difference(same);
+		same.set_difference(same);
+		std::cout << ", difference with a copy: " << evens.size() << ", with itself: " << same.size();
+		std::cout << ", valid " << validMap(evens) << " " << validMap(same) << std::endl;
+
+		ranked_map				ranked;
+		ranked_map				ranked_other;
+		volume_map				volumes;
+		volume_map				volumes_other;
+
+		for (int i = 0; i < 500; i++) {
+			ranked[i * 2] = i;
+			ranked_other[i * 3] = i;
+			volumes.insert(std::make_pair(i * 2, i));
+			volumes_other.insert(std::make_pair(i * 3, i));
+		}
+		ranked.set_union(ranked_other);
+		volumes.set_difference(volumes_other);
+		std::cout << "augmented: union valid " << validRanks(ranked) << " " << validRanks(ranked_other);
+		std::cout << ", size " << ranked.size() << ", nth(400) " << ranked.nth(400)->first;
+		std::cout << ", difference valid " << validSummaries(volumes) << ", total " << volumes.aggregate() << std::endl;
+	}
 	return (EXIT_SUCCESS);
 }
@@ -31,14 +31,14 @@
 # define _VECTOR_HPP_
 
 # include "Iterator.hpp"
+# include "../List/Uninitialized.hpp"
 
 namespace ft
 {
 	template <typename T>
 	void	swap_element(T &x, T &y) {
-		T	tmp;
-	
-		tmp = x;
+		T	tmp(x);
+
 		x = y;
 		y = tmp;
 	};
@@ -63,6 +63,129 @@ namespace ft
 			return (i);
 		};
 
+		//Destroys the elements and gives the storage back to the allocator
+		void	release(void) {
+			destroy_range_a(_vector, _vector + _size, _allocator);
+			if (_vector)
+				_allocator.deallocate(_vector, _capacity);
+			_vector = NULL;
+			_size = 0;
+			_capacity = 0;
+		};
+
+		/*
+		** Storage of new_cap elements holding copies of [0, pos) and of [pos, end)
+		** count slots further, [pos, pos + count) left raw for the caller to fill.
+		** The current elements are untouched, so a value or range to insert may refer to them.
+		*/
+		T*		relocate_with_gap(size_t new_cap, size_t pos, size_t count) {
+			T	*storage = _allocator.allocate(new_cap);
+			T	*head = storage;
+
+			try {
+				head = uninitialized_copy_a(_vector, _vector + pos, storage, _allocator);
+				uninitialized_copy_a(_vector + pos, _vector + _size, storage + pos + count, _allocator);
+			}
+			catch (...) {
+				destroy_range_a(storage, head, _allocator);
+				_allocator.deallocate(storage, new_cap);
+				throw;
+			}
+			return (storage);
+		};
+
+		//Gives back storage from relocate_with_gap() whose gap could not be filled
+		void	discard_with_gap(T *storage, size_t new_cap, size_t pos, size_t count) {
+			destroy_range_a(storage, storage + pos, _allocator);
+			destroy_range_a(storage + pos + count, storage + _size + count, _allocator);
+			_allocator.deallocate(storage, new_cap);
+		};
+
+		//Gives the current storage back and takes storage of new_cap elements holding size elements
+		void	adopt(T *storage, size_t new_cap, size_t size) {
+			release();
+			_vector = storage;
+			_size = size;
+			_capacity = new_cap;
+		};
+
+		//Capacity after growing to hold count more elements: doubled, or exactly what is needed
+		size_t	grown_capacity(size_t count) const {
+			size_t	new_cap = _capacity ? _capacity * 2 : 1;
+
+			if ((_capacity > max_size() / 2) || (new_cap > max_size()))
+				new_cap = max_size();
+			if (new_cap < _size + count)
+				new_cap = _size + count;
+			return (new_cap);
+		};
+
+		/*
+		** In place insertions, capacity must suffice. Slots are only ever constructed at the end:
+		** the tail is first copied into raw storage past it, then shifted by assignment.
+		** If a copy into raw storage throws, the vector is left as it was; if an assignment
+		** throws, every element is still constructed and counted in the size.
+		*/
+		void	insert_in_place(size_t pos, size_t count, const T &value) {
+			T		*end = _vector + _size;
+			size_t	after = _size - pos;
+			size_t	i;
+
+			if (after > count) {
+				uninitialized_copy_a(end - count, end, end, _allocator);
+				_size += count;
+				assign_range_backward(_vector + pos, end - count, end);
+				for (i = pos; i < pos + count; i++)
+					_vector[i] = value;
+				return ;
+			}
+			uninitialized_fill_n_a(end, count - after, value, _allocator);
+			_size += count - after;
+			try {
+				uninitialized_copy_a(_vector + pos, end, end + count - after, _allocator);
+			}
+			catch (...) {
+				destroy_range_a(end, end + count - after, _allocator);
+				_size -= count - after;
+				throw;
+			}
+			_size += after;
+			for (i = pos; i < pos + after; i++)
+				_vector[i] = value;
+		};
+
+		template <class InputIt>
+		void	insert_in_place(size_t pos, size_t count, InputIt first, InputIt last) {
+			T		*end = _vector + _size;
+			size_t	after = _size - pos;
+			InputIt	mid = first;
+			size_t	i;
+
+			if (after > count) {
+				uninitialized_copy_a(end - count, end, end, _allocator);
+				_size += count;
+				assign_range_backward(_vector + pos, end - count, end);
+				for (i = pos; first != last; ++first, ++i)
+					_vector[i] = *first;
+				return ;
+			}
+			for (i = 0; i < after; i++)
+				++mid;
+			uninitialized_copy_a(mid, last, end, _allocator);
+			_size += count - after;
+			try {
+				uninitialized_copy_a(_vector + pos, end, end + count - after, _allocator);
+			}
+			catch (...) {
+				destroy_range_a(end, end + count - after, _allocator);
+				_size -= count - after;
+				throw;
+			}
+			_size += after;
+			for (i = pos; first != mid; ++first, ++i)
+				_vector[i] = *first;
+		};
+
 	//https://en.cppreference.com/w/cpp/container/vector
 	//Member types
 	public:
@@ -82,94 +205,99 @@ namespace ft
 		//https://en.cppreference.com/w/cpp/container/vector/vector
 		//MEMBER FUNCTIONS
 		//Default constructor. Constructs an empty container with a default-constructed allocator.
-		vector(void) : _allocator(allocator_type()), _size(0), _capacity(0) {};
+		vector(void) : _vector(NULL), _allocator(allocator_type()), _size(0), _capacity(0) {};
 		
 		//Constructs an empty container with the given allocator alloc.
 		explicit vector(const allocator_type &allocator) :
-			_allocator(allocator), _size(0), _capacity(0) {};
+			_vector(NULL), _allocator(allocator), _size(0), _capacity(0) {};
 
 		//Constructs the container with count copies of elements with value value.
 		explicit vector(size_type count, const T &value = T(), const allocator_type &allocator = allocator_type()) :
-			_allocator(allocator), _size(0) {
+			_vector(NULL), _allocator(allocator), _size(0), _capacity(0) {
 				if ((count > max_size()) || (count < 0))
 					throw std::length_error("Capacity exeeds limit");
-				else {
-					_capacity = count;
-					_vector = new T[_capacity];
+				else
 					assign(count, value);
-				}
 		};
 		
 		explicit vector(int count, const T &value = T(), const allocator_type &allocator = allocator_type()) :
-			_allocator(allocator), _size(0) {
+			_vector(NULL), _allocator(allocator), _size(0), _capacity(0) {
 				if (count > 0) {
 					if (static_cast<size_type>(count) > max_size())
 						throw std::length_error("Capacity exeeds limit");
-					else {
-						_capacity = count;
-						_vector = new T[_capacity];
+					else
 						assign(count, value);
-					}
 				}
 		};
 
 		//Constructs the container with the contents of the range [first, last).
 		template <class InputIt>
 		vector(InputIt first, InputIt last, const allocator_type &allocator = allocator_type()) :
-			_allocator(allocator), _size(0) {
-				_capacity = distance(first, last);
-				_vector = new T[_capacity];
+			_vector(NULL), _allocator(allocator), _size(0), _capacity(0) {
 				assign<InputIt>(first, last);
 		};
 
 		//Copy constructor. Constructs the container with the copy of the contents of other
-		vector(const vector &copy) : _allocator(copy._allocator), _size(0), _capacity(copy.capacity()) {
-			_vector = new T[_capacity];
+		vector(const vector &copy) : _vector(NULL), _allocator(copy._allocator), _size(0), _capacity(0) {
+			reserve(copy.capacity());
 			assign(copy.begin(), copy.end());
 		};
 
-		//Destructor: clears allocator and deletes vector elements
+		//Destructor: destroys the elements and gives the storage back to the allocator
 		~vector(void) {
-			if (_capacity)
-				delete [] _vector;
+			release();
 		};
 
 		//https://en.cppreference.com/w/cpp/container/vector/operator%3D
-		//Replaces content of one container to another
+		/*
+		** Replaces content of one container to another.
+		** Storage of the old allocator is given back to it before the allocator is replaced.
+		*/
 		vector&					operator=(const vector &other) {
-			_allocator = other._allocator;
-			if (other.capacity() > _capacity) {
-				if (_capacity)
-					delete [] _vector;
-				_capacity = other.capacity();
-				_vector = new T[_capacity];
+			if (this != &other) {
+				if ((other.capacity() > _capacity) || (_allocator != other._allocator)) {
+					release();
+					_allocator = other._allocator;
+					reserve(other.capacity());
+				}
+				assign(other.begin(), other.end());
 			}
-			assign(other.begin(), other.end());
 			return (*this);
 		};
 
 		//https://en.cppreference.com/w/cpp/container/vector/assign
 		//Replaces the contents with count copies of value value
 		void					assign(size_type count, const_reference value) {
+			T	copy(value);
+
 			clear();
-			while (count--)
-				push_back(value);
+			if (count > _capacity)
+				reserve(count);
+			uninitialized_fill_n_a(_vector, count, copy, _allocator);
+			_size = count;
 		};
 		
 		void					assign(int count, const_reference value) {
-			if (count > 0) {
-				clear();
-				while (count--)
-					push_back(value);
-			}
+			if (count > 0)
+				assign(static_cast<size_type>(count), value);
 		};
 
 		//Replaces the contents with copies of those in the range [first, last)
 		template <class InputIt>
 		void					assign(InputIt first, InputIt last) {
+			size_type	count = distance(first, last);
+
 			clear();
-			while (first != last)
-				push_back(*(first++));
+			if (count > _capacity)
+				reserve(count);
+			uninitialized_copy_a(first, last, _vector, _allocator);
+			_size = count;
+		};
+
+		//https://en.cppreference.com/w/cpp/container/vector/get_allocator
+		//Returns the allocator associated with the container.
+		allocator_type			get_allocator(void) const {
+			return (_allocator);
 		};
 
 		//https://en.cppreference.com/w/cpp/container/vector
@@ -282,21 +410,8 @@ namespace ft
 		void					reserve(size_type new_cap) {
 			if (new_cap > max_size())
 				throw std::length_error("Capacity exeeds limit");
-			if (new_cap > _capacity) {
-				pointer		tmp;
-				size_type	i = -1;
-				
-				if (!_capacity)
-					tmp = new T[1];
-				else
-					tmp = new T[new_cap];
-				while (++i < _size)
-					tmp[i] = _vector[i];
-				if (_capacity)
-					delete [] _vector;
-				_vector = tmp;
-				_capacity = new_cap;
-			}
+			if (new_cap > _capacity)
+				adopt(relocate_with_gap(new_cap, _size, 0), new_cap, _size);
 		};
 
 		//https://en.cppreference.com/w/cpp/container/vector/capacity
@@ -310,152 +425,104 @@ namespace ft
 		//Erases all elements from the container. After this call, size() returns zero.
 		//Leaves the capacity() of the vector unchanged.
 		void					clear(void) {
-			erase(begin(), end());
+			destroy_range_a(_vector, _vector + _size, _allocator);
+			_size = 0;
 		};
 
 		//https://en.cppreference.com/w/cpp/container/vector/insert
 		//Inserts value before pos
 		//Returns iterator pointing to the inserted value
 		iterator				insert(iterator pos, const_reference value) {
-			if (pos == end()) {
-				push_back(value);
-				pos = end();
-			}
-			else {
-				pointer		tmp;
-				iterator	it = begin();
-				size_type	i = 0;
-
-				while (it != pos) {
-					i++;
-					it++;
-				}
-				tmp = new T[_size - i];
-				size_type j = 0;
-				while (it != end()) {
-					tmp[j] = *it;
-					it++;
-					j++;
-				}
-				if ((_size + 1) > max_size())
-					throw std::length_error("Capacity exeeds limit");
-				if ((_size + 1) > _capacity) {
-					pointer		new_v;
-					size_type	k = 0;;
-					
-					if (!_capacity)
-						new_v = new T[1];
-					else if (_capacity * 2 < max_size())
-						new_v = new T[_capacity * 2];
-					else
-						new_v = new T[max_size()];
-					while (k < _size) {
-						new_v[k] = _vector[k];
-						k++;
-					}
-					if (_capacity)
-						delete [] _vector;
-					_vector = new_v;
-					if (!_capacity)
-						_capacity++;
-					else if (_capacity * 2 < max_size())
-						_capacity *= 2;
-					else
-						_capacity = max_size();
+			size_type	i = pos.get_vector() - _vector;
+
+			insert(pos, static_cast<size_type>(1), value);
+			return (iterator(_vector + i));
+		};
+
+		/*
+		** Inserts count copies of the value before pos.
+		** Every element is moved once, straight to its final place: into new storage
+		** when the capacity is exceeded, count slots up otherwise.
+		*/
+		void					insert(iterator pos, size_type count, const_reference value) {
+			size_type	i = pos.get_vector() - _vector;
+			size_type	new_cap;
+			pointer		storage;
+
+			if (!count)
+				return ;
+			if (count > max_size() - _size)
+				throw std::length_error("Capacity exeeds limit");
+			if ((_size + count) > _capacity) {
+				new_cap = grown_capacity(count);
+				storage = relocate_with_gap(new_cap, i, count);
+				try {
+					uninitialized_fill_n_a(storage + i, count, value, _allocator);
 				}
-				_vector[i++] = value;
-				pos = iterator(_vector + i);
-				j = 0;
-				while (i < _size + 1) {
-					_vector[i] = tmp[j];
-					i++;
-					j++;
+				catch (...) {
+					discard_with_gap(storage, new_cap, i, count);
+					throw;
 				}
-				_size++;
+				adopt(storage, new_cap, _size + count);
+				return ;
 			}
-			return (--pos);
-		};
+			//value may be an element about to be moved
+			T	copy(value);
 
-		//Inserts count copies of the value before pos
-		void					insert(iterator pos, size_type count, const_reference value) {
-			while (count--)
-				pos = insert(pos, value);
+			insert_in_place(i, count, copy);
 		};
 		
 		void					insert(iterator pos, int count, const_reference value) {
 			if (count > 0)
-				while (count--)
-					pos = insert(pos, value);
+				insert(pos, static_cast<size_type>(count), value);
 		};
 
 		//Inserts elements from range [first, last) before pos.
 		template <class InputIt>
 		void					insert(iterator pos, InputIt first, InputIt last) {
+			size_type	i = pos.get_vector() - _vector;
 			size_type	n = distance(first, last);
-			if (first != last) {
-				if (pos == end()) {
-					while (first != last)
-						push_back(*(first++));
+			size_type	new_cap;
+			pointer		storage;
+
+			if (!n)
+				return ;
+			if (n > max_size() - _size)
+				throw std::length_error("Capacity exeeds limit");
+			if ((_size + n) > _capacity) {
+				new_cap = grown_capacity(n);
+				storage = relocate_with_gap(new_cap, i, n);
+				try {
+					uninitialized_copy_a(first, last, storage + i, _allocator);
 				}
-				else {
-					pointer		tmp;
-					iterator	it;
-					size_type	i = 0;
-
-					for (it = begin(); it != pos; it++)
-						i++;
-					tmp = new T[_size - i];
-					size_type j = 0;
-					while (it != end())
-						tmp[j++] = *(it++);
-					if ((_size + n) > max_size())
-						throw std::length_error("Capacity exeeds limit");
-					if ((_size + n) > _capacity) {
-						try {
-							reserve(_capacity * 2);
-						}
-						catch (const std::exception& e) {
-							std::cerr << e.what() << std::endl;
-							return ;
-						}
-					}
-					while (first != last)
-						_vector[i++] = *(first++);
-					j = 0;
-					while (i < _size + n)
-						_vector[i++] = tmp[j++];
-					_size += n;
+				catch (...) {
+					discard_with_gap(storage, new_cap, i, n);
+					throw;
 				}
+				adopt(storage, new_cap, _size + n);
+				return ;
 			}
+			insert_in_place(i, n, first, last);
 		};
 
 		//https://en.cppreference.com/w/cpp/container/vector/erase
 		//Removes the element at pos.
 		//Returns iterator following the last removed element.
 		iterator				erase(iterator pos) {
-			iterator	it = end();
-			vector<T>	tmp = *this;
-			iterator	cit = tmp.end();
-
-			while (it != pos) {
-				--it;
-				*it = *cit;
-				cit--;
-			}
-			_size--;
-			return (it);
+			iterator	last = pos;
+
+			return (erase(pos, ++last));
 		};
 
 		//Removes the elements in the range [first, last).
 		//Returns iterator following the last removed element.
 		iterator				erase(iterator first, iterator last) {
-			iterator	it = first;
-			
-			while (it != last) {
-				it = erase(it);
-				last--;
-			}
-			return (last);
+			size_type	count = last.get_vector() - first.get_vector();
+
+			assign_range(last.get_vector(), _vector + _size, first.get_vector());
+			destroy_range_a(_vector + _size - count, _vector + _size, _allocator);
+			_size -= count;
+			return (first);
 		};
 
 		//https://en.cppreference.com/w/cpp/container/vector/push_back
@@ -468,17 +535,19 @@ namespace ft
 		*/
 		void					push_back(const_reference value) {
 			if ((_size + 1) > _capacity) {
+				T	copy(value);
+
 				try {
-					if (!_capacity)
-						reserve(1);
-					else
-						reserve(_capacity * 2);
+					reserve(grown_capacity(1));
 				} catch (const std::exception& e) {
 		   			std::cerr << e.what() << std::endl;
 					return ;
 				}
+				_allocator.construct(_vector + _size, copy);
 			}
-			_vector[_size++] = value;
+			else
+				_allocator.construct(_vector + _size, value);
+			_size++;
 		};
 
 		//https://en.cppreference.com/w/cpp/container/vector/pop_back
@@ -488,7 +557,7 @@ namespace ft
 		** Iterators and references to the last element, as well as the end() iterator, are invalidated.
 		*/
 		void					pop_back() {
-			erase(end());
+			_allocator.destroy(_vector + --_size);
 		};
 		
 		//https://en.cppreference.com/w/cpp/container/vector/resize
@@ -0,0 +1,56 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench.cpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mskinner <v.golskiy@ya.ru>                 +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2021/06/28 10:12:44 by mskinner          #+#    #+#             */
+/*   Updated: 2021/06/28 10:12:44 by mskinner         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+//clang++ -Wall -Werror -Wextra -std=c++98 -O2 bench.cpp
+//Timings of ft::vector, kept out of main.cpp so that the tests print the same output on every run
+
+#include "Vector.hpp"
+#include "../List/HugePageAllocator.hpp"
+
+//Sums values at pseudo-random positions, returns the elapsed milliseconds
+template <class Vector>
+double	random_lookups(const Vector &v, std::size_t lookups, long &sum) {
+	std::size_t	state = 1;
+	clock_t		start = clock();
+
+	while (lookups--) {
+		state = state * 6364136223846793005UL + 1442695040888963407UL;
+		sum += v[(state >> 20) % v.size()];
+	}
+	return (static_cast<double>(clock() - start) * 1000 / CLOCKS_PER_SEC);
+}
+
+int main(void)
+{
+	std::cout << "vector RANDOM LOOKUP BENCHMARK (32M ELEMENTS, 16M LOOKUPS) >>>" << std::endl;
+	std::size_t										elements = 32 * 1024 * 1024;
+	std::size_t										lookups = 16 * 1024 * 1024;
+	long											plain_sum = 0;
+	long											huge_sum = 0;
+	double											plain_time;
+	double											huge_time;
+	{
+		ft::vector<long>	plain(elements, 1L);
+
+		plain_time = random_lookups(plain, lookups, plain_sum);
+	}
+	{
+		ft::vector<long, ft::HugePageAllocator<long> >	huge(elements, 1L);
+
+		huge_time = random_lookups(huge, lookups, huge_sum);
+	}
+	std::cout << "std::allocator: " << lookups / plain_time / 1000 << " M lookups/s" << std::endl;
+	std::cout << "ft::HugePageAllocator: " << lookups / huge_time / 1000 << " M lookups/s" << std::endl;
+	std::cout << "same sums: " << (plain_sum == huge_sum) << std::endl;
+
+	return (0);
+}
@@ -13,10 +13,41 @@
 //clang++ -Wall -Werror -Wextra -std=c++98 main.cpp
 
 #include "Vector.hpp"
+#include "../List/MemoryResource.hpp"
+#include "../List/HugePageAllocator.hpp"
 #include <vector>
+#include <stdexcept>
 
 typedef bool	(* Compare)(const int &, const int &);
 
+//Element whose copy throws once, when copies_left drops to zero
+int		copies_left = -1;
+long	fragiles_live = 0;
+
+struct Fragile {
+	int	value;
+
+	Fragile(int val = 0) : value(val) {
+		fragiles_live++;
+	};
+	Fragile(const Fragile &copy) : value(copy.value) {
+		if (copies_left == 0) {
+			copies_left = -1;
+			throw std::runtime_error("copy failed");
+		}
+		if (copies_left > 0)
+			copies_left--;
+		fragiles_live++;
+	};
+	~Fragile(void) {
+		fragiles_live--;
+	};
+	Fragile&	operator=(const Fragile &other) {
+		value = other.value;
+		return (*this);
+	};
+};
+
 bool	compare(const int &val1, const int &val2) {
 	return (val1 < val2);
 }
@@ -717,4 +748,97 @@ int main(void)
 	std::cout << "ft_: equal: " << (v10 == v13) << ", not equal: " << (v10 != v13);
 	std::cout << ", >: " << (v10 > v13) << ", >=: " << (v10 >= v13) << ", <: " << (v10 < v13);
 	std::cout << ", <=: " << (v10 <= v13) << std::endl;
+
+	std::cout << std::endl << "vector INSERT ROLLBACK TESTS >>>" << std::endl;
+	std::vector<Fragile>	fragiles;
+	ft::vector<Fragile>		fv;
+	for (i = 0; i < 10; i++)
+		fragiles.push_back(Fragile(i));
+	fv.insert(fv.end(), fragiles.begin(), fragiles.end());
+	copies_left = 15;
+	try {
+		fv.insert(fv.begin() + 1, fragiles.begin(), fragiles.end());
+	}
+	catch (std::exception &e) {
+		std::cout << "reallocating range insert threw: " << e.what() << std::endl;
+	}
+	fv.reserve(20);
+	//the copy of the value, one copy past the end, then the first copy of the tail throws
+	copies_left = 2;
+	try {
+		fv.insert(fv.begin() + 8, static_cast<std::size_t>(3), Fragile(42));
+	}
+	catch (std::exception &e) {
+		std::cout << "in place count insert threw: " << e.what() << std::endl;
+	}
+	std::cout << "vector left unchanged, size: " << fv.size() << " [";
+	for (i = 0; i < static_cast<int>(fv.size()); i++)
+		std::cout << fv[i].value << ((i + 1 == static_cast<int>(fv.size())) ? "" : ", ");
+	std::cout << "]" << std::endl;
+	fv.assign(fragiles.begin(), fragiles.begin() + 8);
+	fv.reserve(16);
+	//the copy of the value, then two copies of the tail: the third copy throws while shifting
+	copies_left = 2;
+	try {
+		fv.insert(fv.begin(), static_cast<std::size_t>(3), Fragile(42));
+	}
+	catch (std::exception &e) {
+		std::cout << "in place insert threw while shifting: " << e.what() << std::endl;
+	}
+	//two elements copied past the end, then the first copy of the tail throws
+	copies_left = 2;
+	try {
+		fv.insert(fv.begin() + 6, fragiles.begin(), fragiles.begin() + 4);
+	}
+	catch (std::exception &e) {
+		std::cout << "in place range insert threw while shifting: " << e.what() << std::endl;
+	}
+	std::cout << "vector left unchanged, size: " << fv.size() << " [";
+	for (i = 0; i < static_cast<int>(fv.size()); i++)
+		std::cout << fv[i].value << ((i + 1 == static_cast<int>(fv.size())) ? "" : ", ");
+	std::cout << "], live elements: " << fragiles_live << std::endl;
+	fv.clear();
+	fragiles.clear();
+	std::cout << "live elements after clear: " << fragiles_live << std::endl;
+
+	std::cout << std::endl << "vector memory_resource TESTS >>>" << std::endl;
+	char								stack_buffer[256];
+	ft::monotonic_buffer_resource		monotonic(stack_buffer, sizeof(stack_buffer));
+	ft::unsynchronized_pool_resource	pooled;
+	ft::pmr::vector<int>::type			pv1(&monotonic);
+	ft::pmr::vector<int>::type			pv2(arr1, arr1 + 5, &pooled);
+	char								*data;
+	for (i = 0; i < 10; i++)
+		pv1.push_back(i);
+	pv1.erase(pv1.begin(), pv1.begin() + 5);
+	pv2.insert(pv2.begin() + 2, static_cast<std::size_t>(3), -1);
+	std::cout << "monotonic: ";
+	printContainer(pv1);
+	std::cout << "pool: ";
+	printContainer(pv2);
+	data = reinterpret_cast<char *>(&pv1[0]);
+	std::cout << "storage in the stack buffer: ";
+	std::cout << ((data >= stack_buffer) && (data < stack_buffer + sizeof(stack_buffer))) << std::endl;
+	pv1.swap(pv2);
+	std::cout << "resources follow the swap: " << (pv1.get_allocator().resource() == &pooled);
+	std::cout << " " << (pv2.get_allocator().resource() == &monotonic) << std::endl;
+	ft::pmr::vector<int>::type			pv3(pv1);
+	pv3.resize(20, 7);
+	std::cout << "copy shares the resource: ";
+	printContainer(pv3);
+	pv3 = pv2;
+	std::cout << "assigned, resource of the source: " << (pv3.get_allocator().resource() == &monotonic) << std::endl;
+
+	std::cout << std::endl << "vector HugePageAllocator TESTS >>>" << std::endl;
+	ft::vector<long, ft::HugePageAllocator<long> >	hv1;
+	ft::vector<long, ft::HugePageAllocator<long> >	hv2((ft::HugePageAllocator<long>(true)));
+	for (i = 0; i < 1000; i++)
+		hv1.push_back(i);
+	std::cout << "small storage from operator new, size: " << hv1.size() << ", back: " << hv1.back() << std::endl;
+	hv2.resize(1 << 20, 1);
+	std::cout << "large storage on a huge page boundary: ";
+	std::cout << (reinterpret_cast<std::size_t>(&hv2[0]) % ft::HugePages::page_size == 0) << std::endl;
+	hv2.push_back(2);
+	std::cout << "grown, size: " << hv2.size() << ", front: " << hv2.front() << ", back: " << hv2.back();
+	std::cout << ", numa-local: " << hv2.get_allocator().numa_local() << std::endl;
 };